@@ -0,0 +1,89 @@
+#include "constants.h"
+#include "Neurone.h"
+#include "Random.h"
+#include <chrono>
+#include <iomanip>
+
+/*
+ Accuracy versus throughput of the integration schemes of Neurone::update().
+ Each neuron type is driven by several constant currents and integrated with each scheme. The spike times are compared to a reference computed with RK4 and a very fine step (1/1024 ms).
+ Usage : ./benchIntegrators [duration in ms]
+*/
+
+struct Trajectory {
+    std::vector<size_t> spikes;
+    size_t evaluations;
+    double seconds;
+};
+
+Trajectory integrate(Neurone neuron, double current, const Integration& integration, size_t duration)
+{
+    Trajectory result{{}, 0, 0.0};
+    auto start(std::chrono::steady_clock::now());
+    for (size_t t(1); t<=duration; ++t) {
+        neuron.setCurrent(current);
+        result.evaluations += neuron.update(integration);
+        if (neuron.isFiring()) result.spikes.push_back(t);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    size_t duration(argc>1 ? std::stoul(argv[1]) : 2000);
+    const std::vector<double> currents{4.0, 7.0, 10.0, 15.0};
+    const std::vector<std::pair<std::string, Integration>> schemes{
+        {"original", {ORIGINAL, 0.5, _INTEGRATION_TOLERANCE_}},
+        {"euler h=0.5", {EULER, 0.5, _INTEGRATION_TOLERANCE_}},
+        {"euler h=0.1", {EULER, 0.1, _INTEGRATION_TOLERANCE_}},
+        {"euler h=0.01", {EULER, 0.01, _INTEGRATION_TOLERANCE_}},
+        {"rk2 h=0.5", {RK2, 0.5, _INTEGRATION_TOLERANCE_}},
+        {"rk2 h=0.1", {RK2, 0.1, _INTEGRATION_TOLERANCE_}},
+        {"rk4 h=1", {RK4, 1.0, _INTEGRATION_TOLERANCE_}},
+        {"rk4 h=0.5", {RK4, 0.5, _INTEGRATION_TOLERANCE_}},
+        {"rk4 h=0.25", {RK4, 0.25, _INTEGRATION_TOLERANCE_}},
+        {"adaptive tol=1e-1", {ADAPTIVE, _INTEGRATION_STEP_, 1e-1}},
+        {"adaptive tol=1e-2", {ADAPTIVE, _INTEGRATION_STEP_, 1e-2}},
+        {"adaptive tol=1e-3", {ADAPTIVE, _INTEGRATION_STEP_, 1e-3}},
+    };
+    const Integration reference{RK4, 1.0/1024, _INTEGRATION_TOLERANCE_};
+
+    RandomNumbers generator(_SEED_);
+    std::vector<Neurone> neurons;
+    for (const auto& type : NeuronParam) neurons.push_back(Neurone(type.first, generator));
+
+    std::vector<std::vector<size_t>> referenceSpikes;
+    for (const auto& neuron : neurons) {
+        for (auto current : currents) referenceSpikes.push_back(integrate(neuron, current, reference, duration).spikes);
+    }
+
+    std::cout << std::left << std::setw(24) << "scheme" << std::right << std::setw(14) << "evals/ms" << std::setw(14) << "ns/ms" << std::setw(18) << "spike count err" << std::setw(18) << "spike time err" << std::endl;
+    for (const auto& scheme : schemes) {
+        size_t evaluations(0), spikeCountError(0), referenceCount(0), matched(0);
+        double seconds(0.0), timeError(0.0);
+        size_t r(0);
+        for (const auto& neuron : neurons) {
+            for (auto current : currents) {
+                Trajectory trajectory(integrate(neuron, current, scheme.second, duration));
+                const std::vector<size_t>& expected(referenceSpikes[r++]);
+                evaluations += trajectory.evaluations;
+                seconds += trajectory.seconds;
+                referenceCount += expected.size();
+                spikeCountError += std::max(expected.size(), trajectory.spikes.size()) - std::min(expected.size(), trajectory.spikes.size());
+                for (size_t k(0); k<std::min(expected.size(), trajectory.spikes.size()); ++k) {
+                    timeError += std::abs(double(trajectory.spikes[k])-double(expected[k]));
+                    ++matched;
+                }
+            }
+        }
+        double neuronMs(double(duration)*neurons.size()*currents.size());
+        std::cout << std::left << std::setw(24) << scheme.first << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << evaluations/neuronMs
+                  << std::setw(14) << 1e9*seconds/neuronMs
+                  << std::setw(17) << 100.0*spikeCountError/std::max<size_t>(referenceCount, 1) << "%"
+                  << std::setw(15) << (matched ? timeError/matched : 0.0) << " ms" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "constants.h"
+#include "Network.h"
+#include "Random.h"
+#include "Topology.h"
+#include <chrono>
+#include <iomanip>
+
+/*
+ Construction time of the small-world and scale-free networks (see Topology.h).
+ The links are drawn by a Topology for several sizes up to the number of neurons given, then a whole Network of this size is built with each model.
+ The last lines compare the preferential attachment of the Topology (the array of the ends of the links) to a scan of the cumulative degrees, whose time is quadratic in the number of neurons.
+ Usage : ./benchTopology [neurons] [mean connectivity]
+*/
+
+double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+/// preferential attachment which draws each target by a scan of the cumulative degrees
+size_t scanScaleFree(size_t n, size_t m, RandomNumbers& generator)
+{
+    std::vector<size_t> degrees(n, 0);
+    size_t total(0), links(0);
+    for (size_t a(0); a<=m; ++a) {
+        degrees[a] = m;
+        total += m;
+    }
+    std::vector<size_t> targets;
+    for (size_t a(m+1); a<n; ++a) {
+        targets.clear();
+        while (targets.size()<m) {
+            size_t draw(generator.uniform_int(0, total-1)), target(0);
+            for (size_t sum(degrees[0]); sum<=draw; sum+=degrees[++target]);
+            if (std::find(targets.begin(), targets.end(), target)==targets.end()) targets.push_back(target);
+        }
+        for (auto target : targets) ++degrees[target];
+        degrees[a] = m;
+        total += 2*m;
+        links += 2*m;
+    }
+    return links;
+}
+
+int main(int argc, char **argv)
+{
+    size_t neurons(argc>1 ? std::stoul(argv[1]) : 1000000);
+    double connectivity(argc>2 ? std::stod(argv[2]) : 10.0);
+
+    std::cout << std::left << std::setw(12) << "model" << std::right << std::setw(12) << "neurons" << std::setw(14) << "links" << std::setw(12) << "seconds" << std::setw(16) << "ns/link" << std::setw(12) << "max degree" << std::endl;
+    for (char model : {'W', 'A'}) {
+        for (size_t n(std::min<size_t>(neurons, 10000)); n<=neurons; n*=10) {
+            RandomNumbers generator(_SEED_);
+            auto start(std::chrono::steady_clock::now());
+            Topology topology(model, n, connectivity, _REWIRING_, generator);
+            double time(seconds(start));
+            size_t maximum(0);
+            for (size_t i(0); i<n; ++i) maximum = std::max(maximum, topology.getDegree(i));
+            std::cout << std::left << std::setw(12) << (model=='W' ? "small-world" : "scale-free") << std::right << std::setw(12) << n << std::setw(14) << topology.getNumberLinks()
+                      << std::fixed << std::setprecision(3) << std::setw(12) << time << std::setprecision(1) << std::setw(16) << 1e9*time/std::max<size_t>(topology.getNumberLinks(), 1) << std::setw(12) << maximum << std::endl;
+            if (n==neurons) break;
+            if (10*n>neurons) n = neurons/10;
+        }
+    }
+
+    std::cout << "\nwhole network of " << neurons << " neurons (neurons, links and strengths)" << std::endl;
+    for (char model : {'B', 'W', 'A'}) {
+        auto start(std::chrono::steady_clock::now());
+        Network network(neurons, _PROPORTION_EXCITATOR_, connectivity, _MEAN_INTENSITY_, _DELTA_, model, nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+        std::cout << "model " << model << " : " << std::fixed << std::setprecision(3) << seconds(start) << " s" << std::endl;
+    }
+
+    std::cout << "\npreferential attachment : ends of the links / scan of the cumulative degrees" << std::endl;
+    size_t m(std::max(1.0, std::round(0.5*connectivity)));
+    for (size_t n(5000); n<=20000; n*=2) {
+        RandomNumbers generator(_SEED_), scanning(_SEED_);
+        auto start(std::chrono::steady_clock::now());
+        Topology topology('A', n, connectivity, 0.0, generator);
+        double ends(seconds(start));
+        start = std::chrono::steady_clock::now();
+        scanScaleFree(n, m, scanning);
+        double scan(seconds(start));
+        std::cout << std::setw(8) << n << " neurons : " << std::fixed << std::setprecision(4) << ends << " s / " << scan << " s" << std::endl;
+    }
+
+    return 0;
+}
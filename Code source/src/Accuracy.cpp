@@ -0,0 +1,62 @@
+#include "Accuracy.h"
+
+Accuracy::Accuracy(Network* reference_, const Network& quantized, size_t duration_, size_t window_) : reference(reference_), quantizedStatistics(quantized, window_), referenceStatistics(*reference_, window_), duration(duration_), window(window_), steps(0), neurons(quantized.getNumberNeurons())
+{
+    if (reference->getNumberNeurons()!=quantized.getNumberNeurons()) throw std::invalid_argument("The accuracy of the quantized links is measured with the same network in double precision, with the same neurons.");
+}
+
+void Accuracy::record(const std::vector<size_t>& fired, size_t time)
+{
+    if (isDone()) return;
+    reference->update(); // the same random sequence as the quantized network, which was updated for this time step
+    quantizedStatistics.record(fired, time);
+    referenceStatistics.record(reference->getFired(), time);
+    if (++steps==duration) reference.reset(); // its memory is only needed during the comparison
+}
+
+void Accuracy::print(std::ostream& outfile) const
+{
+    outfile << "# firing statistics of the network with quantized links and of the same network in double precision (full), over the first " << steps << " time steps (Fano factors on windows of " << window << " time steps)" << std::endl;
+    outfile << "type\tspikes\tfull\tdifference(%)\trate(Hz)\tfull\tfano\tfull\tdifference\n";
+    size_t quantizedTotal(0), referenceTotal(0);
+    const std::vector<std::string>& types(quantizedStatistics.getTypes());
+    for (size_t t(0); t<types.size(); ++t) {
+        size_t quantizedSpikes(quantizedStatistics.getTypeSpikes(t)), referenceSpikes(referenceStatistics.getTypeSpikes(t));
+        quantizedTotal += quantizedSpikes;
+        referenceTotal += referenceSpikes;
+        double quantizedFano(quantizedStatistics.getFanoFactor(t)), referenceFano(referenceStatistics.getFanoFactor(t));
+        outfile << types[t] << "\t" << quantizedSpikes << "\t" << referenceSpikes << "\t" << (referenceSpikes ? 100.0*(double(quantizedSpikes)/referenceSpikes-1.0) : 0.0);
+        outfile << "\t" << quantizedStatistics.getRate(t) << "\t" << referenceStatistics.getRate(t);
+        outfile << "\t" << quantizedFano << "\t" << referenceFano << "\t" << quantizedFano-referenceFano << "\n";
+    }
+    double scale(steps and neurons ? 1000.0/(double(neurons)*steps) : 0.0); // spikes to Hz
+    outfile << "all\t" << quantizedTotal << "\t" << referenceTotal << "\t" << (referenceTotal ? 100.0*(double(quantizedTotal)/referenceTotal-1.0) : 0.0);
+    outfile << "\t" << quantizedTotal*scale << "\t" << referenceTotal*scale;
+    outfile << "\t" << quantizedStatistics.getFanoFactor() << "\t" << referenceStatistics.getFanoFactor() << "\t" << quantizedStatistics.getFanoFactor()-referenceStatistics.getFanoFactor() << "\n";
+    outfile.flush();
+}
+
+bool Accuracy::isDone() const
+{
+    return steps>=duration;
+}
+
+size_t Accuracy::getSteps() const
+{
+    return steps;
+}
+
+const Network* Accuracy::getReference() const
+{
+    return reference.get();
+}
+
+const Statistics& Accuracy::getQuantizedStatistics() const
+{
+    return quantizedStatistics;
+}
+
+const Statistics& Accuracy::getReferenceStatistics() const
+{
+    return referenceStatistics;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Statistics.h"
+#include <memory>
+
+/*! @class Accuracy
+
+ The Accuracy class measures how much the rounding of the quantized links (see \ref QuantizedLinks) changes the activity of a \ref Network : during the first time steps of the simulation, the same network with its links in double precision (the same seed, so the same neurons, links and noise) is simulated beside it, and the firing statistics of both (see \ref Statistics) are compared : number of spikes, mean firing rate and Fano factor of the number of spikes per window of each neuron type and of the whole population.
+
+ The spikes themselves diverge after a few time steps, since a rounded current can change a spike, so only the statistics can be compared. The full precision network is destroyed once its time steps are simulated, so the comparison only takes memory and time at the beginning of the simulation.
+*/
+
+class Accuracy
+{
+
+public:
+
+    /*! @brief Compare two networks with the same neurons.
+        \param reference_ (Network*) : the network in double precision, owned by the Accuracy.
+        \param quantized (Network&) : the network with quantized links, simulated by the owner of the Accuracy.
+        \param duration_ (size_t) : number of time steps of the comparison.
+        \param window (size_t) : number of time steps of the windows of the Fano factors.
+    */
+    Accuracy(Network* reference_, const Network& quantized, size_t duration_, size_t window);
+
+    /*! @brief Record the spikes of the quantized network and update the reference network, until the end of the comparison.
+        \param fired (vector<size_t>) : indices of the neurons of the quantized network which fired.
+        \param time (size_t) : current time step.
+    */
+    void record(const std::vector<size_t>& fired, size_t time);
+
+    /*! @brief Writes the statistics of both networks and their differences, for each type and the whole population.
+        \param outfile (ostream&) : the output file (suffix _accuracy).
+    */
+    void print(std::ostream& outfile) const;
+
+    /*!
+       @name Utility methods (getters)
+       *getReference()* gives the network in double precision, nullptr once the comparison is over.
+    */
+///@{
+    bool isDone() const;
+    size_t getSteps() const;
+    const Network* getReference() const;
+    const Statistics& getQuantizedStatistics() const;
+    const Statistics& getReferenceStatistics() const;
+///@}
+
+private:
+    std::unique_ptr<Network> reference;
+    Statistics quantizedStatistics, referenceStatistics;
+    size_t duration, window, steps;
+    ///number of neurons, for the population rate
+    size_t neurons;
+};
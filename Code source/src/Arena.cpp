@@ -0,0 +1,129 @@
+#include "Arena.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+Arena::Arena(size_t blockSize_, PageMode pages_) : blockSize(blockSize_), pages(pages_), current(nullptr), remaining(0), used(0), reserved(0)
+{
+    if (blockSize==0) throw std::invalid_argument("The blocks of an arena can not be empty.");
+#ifndef __linux__
+    pages = NORMAL_PAGES;
+#endif
+}
+
+Arena::~Arena()
+{
+    for (const auto& block : blocks) { // the blocks are freed all at once
+#ifdef __linux__
+        if (block.mapped) {
+            munmap(block.data, block.size);
+            continue;
+        }
+#endif
+        delete[] block.data;
+    }
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+    size_t padding((alignment - reinterpret_cast<uintptr_t>(current)%alignment)%alignment);
+    if (padding+bytes>remaining) {
+        newBlock(std::max(blockSize, bytes+alignment)); // a new block always has room for an aligned area
+        padding = (alignment - reinterpret_cast<uintptr_t>(current)%alignment)%alignment;
+    }
+    void* area(current+padding);
+    current += padding+bytes;
+    remaining -= padding+bytes;
+    used += bytes;
+    return area;
+}
+
+void Arena::newBlock(size_t size)
+{
+    Block block{nullptr, size, false};
+#ifdef __linux__
+    if (pages!=NORMAL_PAGES) {
+        block.size = (size+_HUGE_PAGE_SIZE_-1)/_HUGE_PAGE_SIZE_*_HUGE_PAGE_SIZE_;
+        void* data(MAP_FAILED);
+        if (pages==EXPLICIT_HUGE_PAGES) data = mmap(nullptr, block.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data==MAP_FAILED) { // no reserved huge page left : a block aligned on a huge page is given to the transparent huge pages
+            char* area(static_cast<char*>(mmap(nullptr, block.size+_HUGE_PAGE_SIZE_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)));
+            if (area==MAP_FAILED) throw std::bad_alloc();
+            size_t head((_HUGE_PAGE_SIZE_ - reinterpret_cast<uintptr_t>(area)%_HUGE_PAGE_SIZE_)%_HUGE_PAGE_SIZE_);
+            if (head>0) munmap(area, head);
+            munmap(area+head+block.size, _HUGE_PAGE_SIZE_-head);
+            data = area+head;
+            madvise(data, block.size, MADV_HUGEPAGE);
+        }
+        block.data = static_cast<char*>(data);
+        block.mapped = true;
+    }
+#endif
+    if (!block.mapped) block.data = new char[block.size];
+    blocks.push_back(block);
+    current = block.data;
+    remaining = block.size;
+    reserved += block.size;
+}
+
+size_t Arena::getUsed() const
+{
+    return used;
+}
+
+size_t Arena::getReserved() const
+{
+    return reserved;
+}
+
+PageMode Arena::getPages() const
+{
+    return pages;
+}
+
+size_t Arena::getHugePages() const
+{
+    size_t bytes(0);
+#ifdef __linux__
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    uintptr_t start(0), end(0);
+    while (std::getline(smaps, line)) {
+        size_t dash(line.find('-'));
+        size_t space(line.find(' '));
+        if (dash!=std::string::npos and space!=std::string::npos and dash<space and line.find(':')>space) { // first line of a mapping : start-end perms ...
+            start = std::stoull(line.substr(0, dash), nullptr, 16);
+            end = std::stoull(line.substr(dash+1, space-dash-1), nullptr, 16);
+            continue;
+        }
+        if (line.find("AnonHugePages:")!=0 and line.find("Private_Hugetlb:")!=0) continue;
+        bool inArena(false);
+        for (const auto& block : blocks) {
+            uintptr_t data(reinterpret_cast<uintptr_t>(block.data));
+            if (data<end and data+block.size>start) inArena = true;
+        }
+        if (inArena) bytes += 1024*std::stoull(line.substr(line.find(':')+1)); // in kB
+    }
+#endif
+    return bytes;
+}
+
+std::map<int, size_t> Arena::getNodes() const
+{
+    std::map<int, size_t> nodes;
+#ifdef __linux__
+    size_t pageSize(sysconf(_SC_PAGESIZE));
+    std::vector<void*> addresses;
+    for (size_t b(0); b<blocks.size(); ++b) {
+        size_t size(b+1==blocks.size() ? blocks[b].size-remaining : blocks[b].size); // the end of the last block is not used yet
+        for (size_t offset(0); offset<size; offset+=pageSize) addresses.push_back(blocks[b].data+offset);
+    }
+    if (addresses.empty()) return nodes;
+    std::vector<int> status(addresses.size(), -1);
+    if (syscall(SYS_move_pages, 0, addresses.size(), addresses.data(), nullptr, status.data(), 0)!=0) status.assign(addresses.size(), -1); // the pages are not moved, move_pages only tells their node
+    for (auto node : status) ++nodes[node<0 ? -1 : node];
+#endif
+    return nodes;
+}
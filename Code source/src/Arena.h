@@ -0,0 +1,135 @@
+#pragma once
+#include "constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <map>
+
+/*! @class Arena
+
+ The Arena class is a bump allocator : the memory is taken from large blocks, by moving a pointer forward, and it is only given back all at once when the Arena is destroyed.
+
+ The \ref Network allocates its neurons and the links of each neuron in an Arena : instead of millions of small allocations (and copies when the lists of links grow), the memory is taken from a few blocks of \ref _ARENA_BLOCK_SIZE_ bytes, the neurons and their links are contiguous in memory, and the destruction of the network only frees the blocks.
+
+ The blocks can be made of huge pages (see \ref PageMode), which divides by 512 the number of TLB entries needed to go through gigabytes of links. The memory of a block is only placed on a NUMA node when it is first written (first touch), so each process of a distributed run (see \ref Communicator) places the links of the neurons it owns on its own node. *getHugePages()* and *getNodes()* tell where the blocks actually are.
+
+ The objects created in an Arena are not destroyed by it : their destructor must be called by their owner before the Arena is destroyed (see \ref Network::~Network()).
+*/
+
+class Arena
+{
+
+public:
+
+    /*! @name Construction and destruction
+        \param blockSize_ (size_t) : number of bytes of each block (a bigger block is taken for a bigger allocation, the blocks of huge pages are rounded to \ref _HUGE_PAGE_SIZE_).
+        \param pages_ (PageMode) : memory pages of the blocks (huge pages are only available on Linux, normal pages are used elsewhere).
+    */
+///@{
+    Arena(size_t blockSize_=_ARENA_BLOCK_SIZE_, PageMode pages_=NORMAL_PAGES);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena();
+///@}
+
+    /*! @brief Give a memory area which stays valid until the Arena is destroyed.
+        \param bytes (size_t) : size of the area.
+        \param alignment (size_t) : alignment of the area (a power of 2).
+    */
+    void* allocate(size_t bytes, size_t alignment=alignof(std::max_align_t));
+
+    /*! @brief Construct an object in the Arena.
+    */
+    template<class T, class... Args>
+    T* create(Args&&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /*!
+       @name Utility methods (getters)
+       *getUsed()* gives the number of bytes given by *allocate()*, *getReserved()* the size of all the blocks.
+       *getHugePages()* gives the number of bytes of the blocks which are in huge pages, as reported by the kernel in /proc/self/smaps.
+       *getNodes()* gives the number of used memory pages on each NUMA node (-1 for the pages which are not in memory, nothing if the nodes are unknown).
+    */
+///@{
+    size_t getUsed() const;
+    size_t getReserved() const;
+    PageMode getPages() const;
+    size_t getHugePages() const;
+    std::map<int, size_t> getNodes() const;
+///@}
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+        ///true if the block was allocated with mmap, false if it was allocated with new
+        bool mapped;
+    };
+    /// allocate a block of at least size bytes
+    void newBlock(size_t size);
+
+    size_t blockSize;
+    PageMode pages;
+    std::vector<Block> blocks;
+    ///free part of the last block
+    char* current;
+    size_t remaining;
+    size_t used, reserved;
+};
+
+/*! @class ArenaAllocator
+
+ Allocator of the standard containers which takes its memory from an \ref Arena : *deallocate()* does nothing, the memory is given back when the Arena is destroyed. Without Arena (nullptr, the default), the memory is taken from the heap as with std::allocator, so that the containers of the objects created outside of a \ref Network (for example in the tests) work as usual. A copied container always uses the heap, since the copy can outlive the Arena.
+*/
+
+template<class T>
+class ArenaAllocator
+{
+
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ArenaAllocator(Arena* arena_=nullptr) : arena(arena_) {}
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (arena) return static_cast<T*>(arena->allocate(n*sizeof(T), alignof(T)));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, size_t n)
+    {
+        if (!arena) std::allocator<T>().deallocate(pointer, n);
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const
+    {
+        return ArenaAllocator();
+    }
+
+    Arena* getArena() const
+    {
+        return arena;
+    }
+
+private:
+    Arena* arena;
+};
+
+template<class T, class U>
+bool operator==(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second)
+{
+    return first.getArena()==second.getArena();
+}
+
+template<class T, class U>
+bool operator!=(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second)
+{
+    return !(first==second);
+}
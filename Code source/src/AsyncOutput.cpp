@@ -0,0 +1,146 @@
+#include "AsyncOutput.h"
+
+AsyncOutput::AsyncOutput(const std::string& fileName, size_t blockSize, size_t queueLength_, std::ios_base::openmode mode) : std::ostream(nullptr), file(fileName, mode), bytesOut(0), buffer(*this, blockSize), queueLength(std::max<size_t>(queueLength_, 1)), opened(file.good()), closing(false), failed(false), bytesIn(0)
+{
+    rdbuf(&buffer);
+    if (!opened) setstate(std::ios_base::badbit);
+}
+
+AsyncOutput::~AsyncOutput()
+{
+    try {
+        close();
+    } catch (SimulError &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void AsyncOutput::submit(TextBuffer& text)
+{
+    if (!opened or text.size()==0) return;
+    if (!buffer.isEmpty() or text.size()<buffer.getBlockSize()) { // a small text goes after the one of the current block
+        text.write(*this);
+        return;
+    }
+    std::vector<char> block(spare());
+    text.swap(block);
+    push(std::move(block));
+}
+
+void AsyncOutput::close()
+{
+    if (!opened) return;
+    opened = false;
+    buffer.submit();
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        changed.notify_all();
+        worker.join();
+    }
+    file.close();
+    if (failed) throw(OUTPUT_ERROR(std::string("A block of an output file could not be written. \n")));
+}
+
+bool AsyncOutput::is_open() const
+{
+    return opened;
+}
+
+size_t AsyncOutput::getBytesIn() const
+{
+    return bytesIn;
+}
+
+size_t AsyncOutput::getBytesOut() const
+{
+    return bytesOut;
+}
+
+bool AsyncOutput::writeBlock(const std::vector<char>& block)
+{
+    file.write(block.data(), block.size());
+    file.flush(); // the block is on the disk, it can already be read
+    bytesOut += block.size();
+    return file.good();
+}
+
+void AsyncOutput::push(std::vector<char>&& block)
+{
+    if (!worker.joinable()) worker = std::thread(&AsyncOutput::work, this); // started here, once the stream is constructed with its writeBlock()
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return queue.size()<queueLength; }); // bounds the memory if the worker is slower than the simulation
+    bytesIn += block.size();
+    queue.push_back(std::move(block));
+    changed.notify_all();
+}
+
+std::vector<char> AsyncOutput::spare()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spares.empty()) return std::vector<char>();
+    std::vector<char> block(std::move(spares.front()));
+    spares.pop_front();
+    return block;
+}
+
+void AsyncOutput::work()
+{
+    while (true) {
+        std::vector<char> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return closing or !queue.empty(); });
+            if (queue.empty()) return; // closing and nothing left to write
+            block = std::move(queue.front());
+            queue.pop_front();
+        }
+        changed.notify_all();
+        if (!writeBlock(block)) failed = true;
+        block.clear(); // its memory is kept for a next block
+        std::lock_guard<std::mutex> lock(mutex);
+        if (spares.size()<queueLength) spares.push_back(std::move(block));
+    }
+}
+
+AsyncOutput::BlockBuffer::BlockBuffer(AsyncOutput& owner_, size_t blockSize_) : owner(owner_), blockSize(std::max<size_t>(blockSize_, 1)), block(blockSize)
+{
+    setp(block.data(), block.data()+block.size());
+}
+
+void AsyncOutput::BlockBuffer::submit()
+{
+    size_t used(pptr()-pbase());
+    if (used==0) return;
+    block.resize(used);
+    owner.push(std::move(block));
+    block = owner.spare();
+    block.resize(blockSize);
+    setp(block.data(), block.data()+block.size());
+}
+
+bool AsyncOutput::BlockBuffer::isEmpty() const
+{
+    return pptr()==pbase();
+}
+
+size_t AsyncOutput::BlockBuffer::getBlockSize() const
+{
+    return blockSize;
+}
+
+AsyncOutput::BlockBuffer::int_type AsyncOutput::BlockBuffer::overflow(int_type c)
+{
+    submit();
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+int AsyncOutput::BlockBuffer::sync()
+{
+    return 0; // the blocks are only written when they are full, flushing each line would make tiny writes
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "TextBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/*! @class AsyncOutput
+
+ An AsyncOutput is an output stream (it can be used like a std::ofstream) whose file is written by a worker thread, so that writing in it never waits for the disk.
+ The text written in the stream is accumulated in large blocks. When a block is full, it is handed to the worker thread through a bounded queue, and the worker writes the blocks in the file in the order of the queue while the simulation goes on. If the worker is slower than the simulation, the stream waits for a free place in the queue, so the memory stays bounded.
+
+ A full \ref TextBuffer can also be handed over without copying its text (see *submit()*) : its memory is exchanged with the one of a block already written, so after the first blocks no memory is allocated.
+
+ Flushing the stream (std::endl) does not write anything, so that the blocks stay large. The last block is written when the stream is closed. The \ref CompressedOutput is an AsyncOutput whose worker compresses the blocks before writing them.
+ */
+
+class AsyncOutput : public std::ostream
+{
+
+public:
+
+    /*! @name Construction and destruction
+        Open the file, the worker thread is started with the first block. The destructor closes the stream (see *close()*) but only reports the errors on the terminal.
+        \param fileName (string) : name of the file to write.
+        \param blockSize (size_t) : size (in bytes) of the blocks.
+        \param queueLength (size_t) : maximal number of blocks waiting to be written.
+        \param mode (openmode) : mode of the file (binary for the compressed files).
+    */
+///@{
+    AsyncOutput(const std::string& fileName, size_t blockSize=_TEXT_BUFFER_SIZE_, size_t queueLength=_OUTPUT_QUEUE_, std::ios_base::openmode mode=std::ios_base::out);
+    virtual ~AsyncOutput();
+///@}
+
+    /*! @brief Hand the text of a buffer to the worker thread and empty the buffer.
+        When the current block is empty and the text fills a block, the memory of the text is exchanged with the one of a written block instead of being copied (the text of a \ref TextBuffer is usually written when it is full), otherwise the text is copied in the current block.
+        \param text (TextBuffer&) : the text to write.
+    */
+    void submit(TextBuffer& text);
+
+    /*! @brief Write the last block, wait until all the blocks are written and close the file.
+        Throws an OUTPUT_ERROR if a block could not be written.
+    */
+    void close();
+    bool is_open() const;
+
+    /*!
+       @name Utility methods (getters)
+       Number of bytes handed to the worker thread and number of bytes written in the file so far.
+    */
+///@{
+    size_t getBytesIn() const;
+    size_t getBytesOut() const;
+///@}
+
+protected:
+
+    /*! @brief Write a block in the file, on the worker thread.
+        \param block (vector<char>) : the text of the block.
+        \return false if the block could not be written.
+    */
+    virtual bool writeBlock(const std::vector<char>& block);
+
+    std::ofstream file;
+    std::atomic<size_t> bytesOut;
+
+private:
+
+    /// the buffer of the stream : it fills the current block and hands the full blocks to the worker thread
+    class BlockBuffer : public std::streambuf
+    {
+    public:
+        BlockBuffer(AsyncOutput& owner_, size_t blockSize_);
+        void submit();
+        bool isEmpty() const;
+        size_t getBlockSize() const;
+    protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+    private:
+        AsyncOutput& owner;
+        size_t blockSize;
+        std::vector<char> block;
+    };
+
+    /// loop of the worker thread : write the blocks in the order of the queue and keep their memory for the next ones
+    void work();
+    void push(std::vector<char>&& block);
+    std::vector<char> spare();
+
+    BlockBuffer buffer;
+    size_t queueLength;
+    std::deque<std::vector<char>> queue, spares;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool opened, closing, failed;
+    std::atomic<size_t> bytesIn;
+    std::thread worker;
+};
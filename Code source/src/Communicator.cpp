@@ -0,0 +1,107 @@
+#include "Communicator.h"
+#include <cstdint>
+#include <cstdlib>
+#ifdef NEURONS_MPI
+#include <mpi.h>
+#endif
+
+Communicator::Communicator(int& argc, char**& argv) : rank(0), size(1)
+{
+#ifdef NEURONS_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+#else
+    (void) argc;
+    (void) argv;
+#endif
+}
+
+Communicator::Communicator() : rank(0), size(1) {}
+
+Communicator::~Communicator()
+{
+#ifdef NEURONS_MPI
+    int initialized(0);
+    MPI_Initialized(&initialized);
+    if (initialized) MPI_Finalize();
+#endif
+}
+
+size_t Communicator::first(size_t neuronNumber) const
+{
+    return (neuronNumber*rank)/size;
+}
+
+size_t Communicator::last(size_t neuronNumber) const
+{
+    return (neuronNumber*(rank+1))/size;
+}
+
+std::vector<size_t> Communicator::allgather(const std::vector<size_t>& local) const
+{
+#ifdef NEURONS_MPI
+    if (size>1) {
+        int count(local.size());
+        std::vector<int> counts(size), displacements(size, 0);
+        MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        for (int r(1); r<size; ++r) displacements[r] = displacements[r-1] + counts[r-1];
+
+        std::vector<uint64_t> send(local.begin(), local.end());
+        std::vector<uint64_t> received(displacements.back() + counts.back());
+        MPI_Allgatherv(send.data(), count, MPI_UINT64_T, received.data(), counts.data(), displacements.data(), MPI_UINT64_T, MPI_COMM_WORLD);
+        return std::vector<size_t>(received.begin(), received.end());
+    }
+#endif
+    return local;
+}
+
+void Communicator::sum(std::vector<double>& values) const
+{
+#ifdef NEURONS_MPI
+    if (size>1) MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#else
+    (void) values;
+#endif
+}
+
+std::string Communicator::gather(const std::string& local) const
+{
+#ifdef NEURONS_MPI
+    if (size>1) {
+        int count(local.size());
+        std::vector<int> counts(size), displacements(size, 0);
+        MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+        for (int r(1); r<size; ++r) displacements[r] = displacements[r-1] + counts[r-1];
+
+        std::string received(isRoot() ? displacements.back() + counts.back() : 0, '\0');
+        MPI_Gatherv(local.data(), count, MPI_CHAR, &received[0], counts.data(), displacements.data(), MPI_CHAR, 0, MPI_COMM_WORLD);
+        return received;
+    }
+#endif
+    return local;
+}
+
+void Communicator::abort(int code) const
+{
+#ifdef NEURONS_MPI
+    if (size>1) MPI_Abort(MPI_COMM_WORLD, code);
+#else
+    (void) code;
+#endif
+}
+
+int Communicator::getRank() const
+{
+    return rank;
+}
+
+int Communicator::getSize() const
+{
+    return size;
+}
+
+bool Communicator::isRoot() const
+{
+    return rank==0;
+}
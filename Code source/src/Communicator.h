@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/*! @class Communicator
+
+ The Communicator class hides the inter-process communication used by the distributed mode of the program.
+ When the program is compiled with MPI (executable \b NeuronsMPI, macro NEURONS_MPI), each process (rank) only stores and updates a contiguous block of neurons of the \ref Network and the Communicator exchanges, at each time step, the indices of the neurons which fired. Otherwise (executable \b Neurons), the Communicator is a single process one and all its methods do nothing.
+
+ A typical command to run the simulation on 4 processes of the same machine is :
+ \verbatim
+ mpirun -np 4 ./NeuronsMPI -N 10000 -P 0.8 -t 1000 -C 40 -I 7 -O test10000
+ \endverbatim
+ The output files are written by the rank 0 only and are identical to the ones of a single process run. All the parameters must be given on the command line because only the rank 0 can read the terminal.
+*/
+
+class Communicator
+{
+
+public:
+
+    /*! @name Construction and destruction
+        The constructor initializes MPI (if used) and the destructor finalizes it, so only one Communicator must exist in a program.
+        \param argc, argv : the arguments of the program, given to MPI.
+    */
+///@{
+    Communicator(int& argc, char**& argv);
+    Communicator();
+    ~Communicator();
+///@}
+
+    /*! @name Partition of the neurons
+        The neurons are distributed in contiguous blocks of (almost) equal size : the rank \b r owns the neurons from \b first(N) to \b last(N)-1.
+        \param neuronNumber (size_t) : total number of neurons in the network.
+    */
+///@{
+    size_t first(size_t neuronNumber) const;
+    size_t last(size_t neuronNumber) const;
+///@}
+
+    /*! @name Collective operations
+        These methods must be called by all the ranks at the same time.
+        \n *allgather()* returns the concatenation (in the rank order) of the indices given by each rank.
+        \n *sum()* replaces each value by its sum over all the ranks.
+        \n *gather()* returns to the rank 0 the concatenation (in the rank order) of the texts given by each rank (the other ranks get an empty text).
+    */
+///@{
+    std::vector<size_t> allgather(const std::vector<size_t>& local) const;
+    void sum(std::vector<double>& values) const;
+    std::string gather(const std::string& local) const;
+///@}
+
+    /*! @brief Stops all the processes with the given exit code (used when one of the rank throws an error, otherwise the others would wait forever).
+    */
+    void abort(int code) const;
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    int getRank() const;
+    int getSize() const;
+    bool isRoot() const;
+///@}
+
+private:
+    int rank;
+    int size;
+};
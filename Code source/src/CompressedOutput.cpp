@@ -0,0 +1,33 @@
+#include "CompressedOutput.h"
+#include <zlib.h>
+
+CompressedOutput::CompressedOutput(const std::string& fileName, size_t blockSize, int level_) : AsyncOutput(fileName, blockSize, _COMPRESSION_QUEUE_, std::ios_base::out | std::ios_base::binary), level(level_) {}
+
+CompressedOutput::~CompressedOutput()
+{
+    try {
+        close(); // before the destruction of the CompressedOutput, the last blocks must still be compressed
+    } catch (SimulError &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+bool CompressedOutput::writeBlock(const std::vector<char>& block)
+{
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY)!=Z_OK) return false; // 15+16 : gzip header and trailer
+    std::vector<unsigned char> compressed(deflateBound(&stream, block.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block.data()));
+    stream.avail_in = block.size();
+    stream.next_out = compressed.data();
+    stream.avail_out = compressed.size();
+    int result(deflate(&stream, Z_FINISH));
+    size_t size(stream.total_out);
+    deflateEnd(&stream);
+    if (result!=Z_STREAM_END) return false;
+
+    file.write(reinterpret_cast<const char*>(compressed.data()), size);
+    file.flush(); // the member is complete on the disk, it can already be read
+    bytesOut += size;
+    return file.good();
+}
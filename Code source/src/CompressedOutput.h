@@ -0,0 +1,35 @@
+#pragma once
+#include "AsyncOutput.h"
+
+/*! @class CompressedOutput
+
+ A CompressedOutput is an output stream (it can be used like a std::ofstream) which writes a gzip file.
+ The text written in the stream is accumulated in large blocks. When a block is full, it is handed to a worker thread (see \ref AsyncOutput) which compresses it as an independent gzip member and appends it to the file, while the simulation goes on. A gzip file made of several members is a valid gzip file : it can be read with *zcat*, *gzfile()* in R (\b RasterPlots.R) or the \b decompress tool of this program. Since each member is complete when it is written, the file can be read while the simulation is still running (up to the last written block).
+
+ Flushing the stream (std::endl) does not compress anything, so that the blocks stay large. The last block is compressed when the stream is closed.
+ */
+
+class CompressedOutput : public AsyncOutput
+{
+
+public:
+
+    /*! @name Construction and destruction
+        Open the file. The destructor closes the stream (see *close()*) but only reports the errors on the terminal.
+        \param fileName (string) : name of the gzip file to write.
+        \param blockSize (size_t) : size (in bytes) of the uncompressed blocks.
+        \param level (int) : zlib compression level (1 : fastest, 9 : smallest).
+    */
+///@{
+    CompressedOutput(const std::string& fileName, size_t blockSize=_COMPRESSION_BLOCK_SIZE_, int level=_COMPRESSION_LEVEL_);
+    ~CompressedOutput();
+///@}
+
+protected:
+
+    /// compress a block as a gzip member and append it to the file, on the worker thread
+    bool writeBlock(const std::vector<char>& block) override;
+
+private:
+    int level;
+};
@@ -0,0 +1,63 @@
+#include "EarlyStop.h"
+
+EarlyStop::EarlyStop(size_t numberNeurons, size_t quiescence_, size_t window_, double threshold_) : neurons(numberNeurons), quiescence(quiescence_), window(window_), threshold(threshold_), silent(0), counts(window_, 0), position(0), filled(0), sum(0), squares(0), stopTime(0)
+{
+    if (window>0 and threshold<0.0) throw std::invalid_argument("The variance threshold of the steady state must be positive.");
+}
+
+bool EarlyStop::record(size_t spikes, size_t time)
+{
+    if (stopTime>0) return true;
+
+    silent = spikes>0 ? 0 : silent+1;
+    if (quiescence>0 and silent>=quiescence) {
+        stopTime = time;
+        reason = "quiescence : no spike during the last " + std::to_string(quiescence) + " time steps";
+        return true;
+    }
+
+    if (window==0) return false;
+    uint64_t old(counts[position]);
+    sum += spikes - old;
+    squares += uint64_t(spikes)*spikes - old*old;
+    counts[position] = spikes;
+    position = (position+1)%window;
+    if (filled<window) ++filled;
+    if (filled==window and getVariance()<threshold) {
+        stopTime = time;
+        std::ostringstream text;
+        text << "steady state : variance of the population rate " << getVariance() << " Hz^2 over the last " << window << " time steps";
+        reason = text.str();
+        return true;
+    }
+    return false;
+}
+
+void EarlyStop::print(std::ostream& outfile, size_t duration) const
+{
+    if (stopTime>0) outfile << "stopped at time step " << stopTime << " of " << duration << ", " << reason << "\n";
+    else outfile << "not stopped : the " << duration << " time steps were simulated, no stopping criterion was met\n";
+}
+
+bool EarlyStop::isStopped() const
+{
+    return stopTime>0;
+}
+
+size_t EarlyStop::getTime() const
+{
+    return stopTime;
+}
+
+const std::string& EarlyStop::getReason() const
+{
+    return reason;
+}
+
+double EarlyStop::getVariance() const
+{
+    if (filled<window or window==0 or neurons==0) return 0.0;
+    double scale(1000.0/(double(neurons)*_DT_)); // spikes per time step to Hz
+    double variance((double(window)*double(squares) - double(sum)*double(sum))/(double(window)*double(window)));
+    return std::max(0.0, variance)*scale*scale;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "constants.h"
+#include <cstdint>
+
+/*! @class EarlyStop
+
+ The EarlyStop class ends a simulation before its duration when its activity does not need to be simulated anymore, so that the points of a parameter sweep which die out or settle down early do not take the time of the whole duration. Two criteria can be used, alone or together :
+ - quiescence : no neuron fired during the last \b K time steps (the activity died out; the noise may start it again, but rarely after a long silence),
+ - steady state : the variance of the population firing rate (in Hz, one value per time step) over a sliding window of the last \b W time steps is below a threshold (in Hz^2). The window only holds the number of spikes of each time step, with their running sum and sum of squares, which are integers : a time step costs a few operations, without rounding errors accumulated along the run.
+
+ The time step and the reason of the stop are written on the terminal and in the output file which name has the suffix _stop (see *print()*).
+*/
+
+class EarlyStop
+{
+
+public:
+
+    /*! @brief Criteria of the stop (0 : not used).
+        \param numberNeurons (size_t) : number of neurons of the network, to compute the population rate.
+        \param quiescence_ (size_t) : number of time steps without spike which stops the simulation.
+        \param window_ (size_t) : number of time steps of the sliding window of the steady state.
+        \param threshold_ (double) : variance of the population rate (Hz^2) below which the steady state stops the simulation.
+    */
+    EarlyStop(size_t numberNeurons, size_t quiescence_, size_t window_, double threshold_);
+
+    /*! @brief Record the number of spikes of a time step and check the criteria.
+        \param spikes (size_t) : number of neurons which fired.
+        \param time (size_t) : current time step.
+        \return true if the simulation must stop (the following calls also return true).
+    */
+    bool record(size_t spikes, size_t time);
+
+    /*! @brief Writes the time step and the reason of the stop, or that no criterion was met.
+        \param outfile (ostream&) : the output file (suffix _stop) or the terminal.
+        \param duration (size_t) : requested duration of the simulation.
+    */
+    void print(std::ostream& outfile, size_t duration) const;
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    bool isStopped() const;
+    /// time step at which the simulation stopped (0 if it did not)
+    size_t getTime() const;
+    /// reason of the stop, empty if the simulation did not stop
+    const std::string& getReason() const;
+    /// variance of the population rate over the last window (Hz^2), 0 until the window is full
+    double getVariance() const;
+///@}
+
+private:
+    size_t neurons, quiescence, window;
+    double threshold;
+    ///time steps since the last spike
+    size_t silent;
+    ///number of spikes of the last time steps (circular buffer), its next position and the number of time steps recorded in it
+    std::vector<uint32_t> counts;
+    size_t position, filled;
+    uint64_t sum, squares;
+    size_t stopTime;
+    std::string reason;
+};
@@ -0,0 +1,91 @@
+#include "LatencyHistogram.h"
+#include <limits>
+
+LatencyHistogram::LatencyHistogram(uint64_t deadline_) : counts(bin(std::numeric_limits<uint64_t>::max())+1, 0), deadline(deadline_), count(0), misses(0), minimum(std::numeric_limits<uint64_t>::max()), maximum(0), sum(0.0) {}
+
+size_t LatencyHistogram::bin(uint64_t value)
+{
+    const uint64_t exact(uint64_t(1) << _LATENCY_PRECISION_BITS_);
+    if (value<exact) return value;
+    unsigned int shift(0); // the value is divided by 2^shift to keep _LATENCY_PRECISION_BITS_ bits
+    while ((value >> shift)>=exact) ++shift;
+    return (exact/2)*shift + (value >> shift);
+}
+
+uint64_t LatencyHistogram::lowest(size_t bin)
+{
+    const uint64_t exact(uint64_t(1) << _LATENCY_PRECISION_BITS_);
+    if (bin<exact) return bin;
+    unsigned int shift(bin/(exact/2)-1);
+    return uint64_t(bin-(exact/2)*shift) << shift;
+}
+
+uint64_t LatencyHistogram::highest(size_t bin)
+{
+    return lowest(bin+1)-1;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    ++counts[bin(value)];
+    ++count;
+    if (deadline>0 and value>deadline) ++misses;
+    if (value<minimum) minimum = value;
+    if (value>maximum) maximum = value;
+    sum += value;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+    if (count==0) return 0;
+    double rank(std::ceil(std::min(std::max(percentile, 0.0), 100.0)/100.0*count));
+    uint64_t seen(0);
+    for (size_t b(0); b<counts.size(); ++b) {
+        seen += counts[b];
+        if (seen>=std::max(rank, 1.0)) return std::min(highest(b), maximum);
+    }
+    return maximum;
+}
+
+void LatencyHistogram::print(std::ostream& outfile) const
+{
+    outfile << "# " << count << " values, " << misses << " above the deadline of " << deadline << " ns, mean " << getMean() << " ns, minimum " << getMinimum() << " ns\n";
+    outfile << "percentile\tlatency\n";
+    for (double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}) outfile << percentile << "\t" << getPercentile(percentile) << "\n";
+    outfile << "max\t" << maximum << "\n";
+    outfile << "lowest\thighest\tcount\n";
+    for (size_t b(0); b<counts.size(); ++b) {
+        if (counts[b]>0) outfile << lowest(b) << "\t" << std::min(highest(b), maximum) << "\t" << counts[b] << "\n";
+    }
+    if (!outfile.good()) throw(OUTPUT_ERROR(std::string("The latency output file is not in good condition, it is impossible to write on it. \n")));
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count;
+}
+
+uint64_t LatencyHistogram::getMisses() const
+{
+    return misses;
+}
+
+uint64_t LatencyHistogram::getDeadline() const
+{
+    return deadline;
+}
+
+uint64_t LatencyHistogram::getMinimum() const
+{
+    return count>0 ? minimum : 0;
+}
+
+uint64_t LatencyHistogram::getMaximum() const
+{
+    return maximum;
+}
+
+double LatencyHistogram::getMean() const
+{
+    return count>0 ? sum/count : 0.0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "constants.h"
+#include <cstdint>
+
+/*! @class LatencyHistogram
+
+ The LatencyHistogram class counts durations (latencies of the time steps, in nanoseconds) in a histogram of the kind of HdrHistogram : the values below 2^\ref _LATENCY_PRECISION_BITS_ have a bin each, then each power of two is divided in 2^(\ref _LATENCY_PRECISION_BITS_ - 1) bins of the same width, so a value is known with a relative error below 2^-(\ref _LATENCY_PRECISION_BITS_ - 1) (less than 1 %), from 1 ns to several centuries.
+
+ All the bins are allocated by the constructor : *record()* only computes the bin of the value and increases its count, without allocation nor system call, so it can be called in a loop which must respect a deadline.
+ The number of values above a deadline (the deadline misses) is counted exactly.
+*/
+
+class LatencyHistogram
+{
+
+public:
+
+    /*! @brief \param deadline_ (uint64_t) : the values strictly above it are counted as deadline misses (0 : no deadline).
+    */
+    LatencyHistogram(uint64_t deadline_=0);
+
+    /*! @brief Count a value.
+        \param value (uint64_t) : the duration, in nanoseconds.
+    */
+    void record(uint64_t value);
+
+    /*! @brief Value below which a given proportion of the values are : the highest value of the bin of the percentile (at most the maximum), 0 if there is no value.
+        \param percentile (double) : between 0 and 100.
+    */
+    uint64_t getPercentile(double percentile) const;
+
+    /*! @brief Writes the number of values and of deadline misses, the mean, the percentiles 50, 90, 99, 99.9, 99.99 and the maximum, then the non empty bins (lowest value, highest value, count), all the durations in ns.
+        \param outfile (ostream&) : the output file (suffix _latency).
+    */
+    void print(std::ostream& outfile) const;
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    uint64_t getCount() const;
+    uint64_t getMisses() const;
+    uint64_t getDeadline() const;
+    uint64_t getMinimum() const;
+    uint64_t getMaximum() const;
+    double getMean() const;
+///@}
+
+private:
+    /// bin of a value, and lowest and highest values of a bin
+    static size_t bin(uint64_t value);
+    static uint64_t lowest(size_t bin);
+    static uint64_t highest(size_t bin);
+
+    std::vector<uint64_t> counts;
+    uint64_t deadline, count, misses, minimum, maximum;
+    double sum;
+};
@@ -0,0 +1,146 @@
+#include "MetricsServer.h"
+#include <cstring>
+#ifdef __unix__
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+uint64_t bits(double value)
+{
+    uint64_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+double value(uint64_t word)
+{
+    double number;
+    std::memcpy(&number, &word, sizeof(number));
+    return number;
+}
+}
+
+MetricsServer::MetricsServer(const std::string& socketName, const Network& network, size_t duration_, const std::string& outfileName_) : name(socketName), outfileName(outfileName_), duration(duration_), periodStart(0), start(std::chrono::steady_clock::now()), periodClock(start), sequence(0), step(0), stepsPerSecond(0), rates(network.getNeuronsProportions().size()), running(true), listener(-1)
+{
+    for (const auto& proportion : network.getNeuronsProportions()) {
+        types.push_back(proportion.first);
+        typeSizes.push_back(proportion.second);
+    }
+    const Neurons& neurons(network.getNeurons());
+    typeOf.resize(neurons.size());
+    for (size_t i(0); i<neurons.size(); ++i) {
+        for (size_t t(0); t<types.size(); ++t) {
+            if (neurons[i]->isType(types[t])) typeOf[i] = t;
+        }
+    }
+    periodSpikes.assign(types.size(), 0);
+    for (auto& rate : rates) rate.store(bits(0.0));
+
+#ifdef __unix__
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (name.empty() or name.size()>=sizeof(address.sun_path)) throw(OUTPUT_ERROR(std::string("The name of the metrics socket must have between 1 and ") + std::to_string(sizeof(address.sun_path)-1) + " characters. \n"));
+    std::strncpy(address.sun_path, name.c_str(), sizeof(address.sun_path)-1);
+    ::unlink(name.c_str());
+    listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener<0 or ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address))!=0 or ::listen(listener, 8)!=0) {
+        if (listener>=0) ::close(listener);
+        throw(OUTPUT_ERROR(std::string("The metrics socket ") + name + " can not be created. \n"));
+    }
+    thread = std::thread(&MetricsServer::serve, this);
+#else
+    throw(OUTPUT_ERROR(std::string("The metrics socket needs a Unix system. \n")));
+#endif
+}
+
+MetricsServer::~MetricsServer()
+{
+    running = false;
+    if (thread.joinable()) thread.join();
+#ifdef __unix__
+    if (listener>=0) {
+        ::close(listener);
+        ::unlink(name.c_str());
+    }
+#endif
+}
+
+void MetricsServer::record(const std::vector<size_t>& fired, size_t time)
+{
+    for (auto i : fired) ++periodSpikes[typeOf[i]];
+    step.store(time, std::memory_order_relaxed);
+
+    std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+    double seconds(std::chrono::duration<double>(now-periodClock).count());
+    if (seconds<_METRICS_PERIOD_ and time<duration) return;
+
+    size_t steps(time-periodStart);
+    uint64_t number(sequence.load(std::memory_order_relaxed));
+    sequence.store(number+1, std::memory_order_relaxed); // odd : the metrics are being written
+    std::atomic_thread_fence(std::memory_order_release);
+    stepsPerSecond.store(bits(seconds>0.0 ? steps/seconds : 0.0), std::memory_order_relaxed);
+    for (size_t t(0); t<types.size(); ++t) {
+        double rate(steps>0 and typeSizes[t]>0 ? 1000.0*periodSpikes[t]/(double(typeSizes[t])*steps*_DT_) : 0.0);
+        rates[t].store(bits(rate), std::memory_order_relaxed);
+        periodSpikes[t] = 0;
+    }
+    sequence.store(number+2, std::memory_order_release);
+    periodStart = time;
+    periodClock = now;
+}
+
+std::string MetricsServer::text() const
+{
+    double speed;
+    std::vector<double> values(types.size());
+    uint64_t before, after;
+    do { // the metrics are copied again if the simulation published new ones meanwhile
+        before = sequence.load(std::memory_order_acquire);
+        speed = value(stepsPerSecond.load(std::memory_order_relaxed));
+        for (size_t t(0); t<types.size(); ++t) values[t] = value(rates[t].load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while (before%2==1 or before!=after);
+
+    std::ostringstream metrics;
+    metrics << "neurons_step " << step.load(std::memory_order_relaxed) << "\n";
+    metrics << "neurons_duration " << duration << "\n";
+    metrics << "neurons_elapsed_seconds " << std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count() << "\n";
+    metrics << "neurons_steps_per_second " << speed << "\n";
+    for (size_t t(0); t<types.size(); ++t) metrics << "neurons_rate_hz{type=\"" << types[t] << "\"} " << values[t] << "\n";
+    metrics << "neurons_resident_bytes " << Network::residentMemory("VmRSS") << "\n";
+#ifdef __unix__
+    for (std::string suffix : {"_spikes.txt", "_sample_neurons.txt", "_parameters.txt", "_parameters.bin", "_probes.txt", "_statistics.txt", "_latency.txt", "_stop.txt", "_accuracy.txt"}) {
+        for (std::string file : {outfileName+suffix, outfileName+suffix+".gz"}) {
+            struct stat status;
+            if (::stat(file.c_str(), &status)==0) metrics << "neurons_output_bytes{file=\"" << file << "\"} " << status.st_size << "\n";
+        }
+    }
+    metrics << "neurons_pid " << ::getpid() << "\n";
+#endif
+    return metrics.str();
+}
+
+void MetricsServer::serve()
+{
+#ifdef __unix__
+    while (running) {
+        pollfd waiting{listener, POLLIN, 0};
+        if (::poll(&waiting, 1, 100)<=0) continue; // the stop of the server is checked every 100 ms
+        int connection(::accept(listener, nullptr, nullptr));
+        if (connection<0) continue;
+        std::string answer(text());
+        for (size_t sent(0); sent<answer.size(); ) {
+            ssize_t written(::send(connection, answer.data()+sent, answer.size()-sent, MSG_NOSIGNAL));
+            if (written<=0) break; // the client left
+            sent += written;
+        }
+        ::close(connection);
+    }
+#endif
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Network.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/*! @class MetricsServer
+
+ The MetricsServer class serves the progress of a running simulation on a local Unix domain socket, so that a long run can be watched (and stopped early) before its output files are written. Each connection receives the current metrics as text, one metric per line in the format of Prometheus, then the connection is closed :
+ \verbatim
+ neurons_step 1234
+ neurons_duration 10000
+ neurons_elapsed_seconds 12.5
+ neurons_steps_per_second 98.7
+ neurons_rate_hz{type="FS"} 11.2
+ neurons_resident_bytes 52428800
+ neurons_output_bytes{file="test_spikes.txt"} 2468000
+ neurons_pid 4242
+ \endverbatim
+ The socket can be read with "socat - UNIX-CONNECT:name" or "nc -U name". The number of steps per second and the firing rate of each type (in Hz) are the ones of the last period of \ref _METRICS_PERIOD_ seconds of wall-clock time, the resident memory of the process and the size of the output files are read when the metrics are requested.
+
+ The simulation calls *record()* at each time step : it counts the spikes of each type and, once per period, publishes the metrics in arrays of atomic values protected by a sequence number (a seqlock) : the simulation never waits for the thread of the server, which copies the metrics again if they were published while it read them.
+ The socket only exists on Unix systems : elsewhere, the constructor throws an OUTPUT_ERROR.
+*/
+
+class MetricsServer
+{
+
+public:
+
+    /*! @brief Create the socket (an existing file of the same name is replaced) and start the thread which answers the connections.
+        \param socketName (string) : name of the socket file.
+        \param network (Network&) : the network simulated, whose neuron types are counted.
+        \param duration_ (size_t) : number of time steps of the simulation.
+        \param outfileName_ (string) : beginning of the names of the output files, whose sizes are served.
+    */
+    MetricsServer(const std::string& socketName, const Network& network, size_t duration_, const std::string& outfileName_);
+
+    /// stop the thread and remove the socket file
+    ~MetricsServer();
+
+    /*! @brief Count the spikes of a time step, and publish the metrics at the end of a period.
+        \param fired (vector<size_t>) : indices of the neurons which fired.
+        \param time (size_t) : current time step.
+    */
+    void record(const std::vector<size_t>& fired, size_t time);
+
+    /*! @brief The text served to a connection.
+    */
+    std::string text() const;
+
+private:
+    /// accept the connections until the server is stopped
+    void serve();
+
+    std::string name, outfileName;
+    size_t duration;
+    std::vector<std::string> types;
+    std::vector<size_t> typeSizes, typeOf;
+    ///spikes of each type and first time step of the current period, counted by the simulation only
+    std::vector<size_t> periodSpikes;
+    size_t periodStart;
+    std::chrono::steady_clock::time_point start, periodClock;
+    ///metrics published : the sequence number is odd while they are written, the doubles are stored as their bits
+    std::atomic<uint64_t> sequence, step;
+    std::atomic<uint64_t> stepsPerSecond;
+    std::vector<std::atomic<uint64_t> > rates;
+    std::atomic<bool> running;
+    int listener;
+    std::thread thread;
+};
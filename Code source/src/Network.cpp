@@ -1,26 +1,42 @@
 #include "constants.h"
 #include "Network.h"
 #include "Random.h"
+#include "ParameterColumns.h"
+#include "Topology.h"
+#include <cmath>
+#include <unordered_map>
 
-Network::Network(size_t neuronNumber, double excitatoryProportion_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_) : meanStrength(meanStrength_), meanConnectivity(meanConnectivity_), excitatoryProportion(excitatoryProportion_), networkModel(networkModel_)
+Network::Network(size_t neuronNumber, double excitatoryProportion_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_, const Communicator* communicator_, PageMode pages, unsigned long int seed, unsigned long int stream, Construction construction, WeightPrecision weights, double rewiring, double denseThreshold) : arena(_ARENA_BLOCK_SIZE_, pages), generator(seed, _STREAMS_*stream), meanStrength(meanStrength_), meanConnectivity(meanConnectivity_), excitatoryProportion(excitatoryProportion_), networkModel(networkModel_), plasticity(nullptr), stimuli(nullptr), quantized(nullptr), procedural(nullptr), steps(0), integration({ORIGINAL, _INTEGRATION_STEP_, _INTEGRATION_TOLERANCE_}), synapses({INSTANTANEOUS_SYNAPSES, _EXCITATORY_TAU_, _INHIBITORY_TAU_}), excitatoryDecay(0.0), inhibitoryDecay(0.0), evaluations(0), communicator(communicator_), dense(ArenaAllocator<float>(&arena)), constructionBaseline(0), constructionPeak(0)
 {
+    constructionBaseline = residentMemory("VmRSS");
     size_t inhibitory(neuronNumber*(1.0-excitatoryProportion));
     size_t excitatory(neuronNumber-inhibitory);
+    neurons.reserve(neuronNumber);
     createNeurons(inhibitory,"FS", delta_);
     if(inhibitory!=0)neuronsProportions["FS"] = inhibitory; //For the map to never be empty, because we need it for the prints. We add the type to the map only if it is not 0 otherwise we will get an empty graph
     createNeurons(excitatory,"RS",delta_);
     if(excitatory!=0)neuronsProportions["RS"] = excitatory;
-    for(auto& neuron : neurons) createRandomLinks(neuron);
+    first = communicator ? communicator->first(neurons.size()) : 0;
+    last = communicator ? communicator->last(neurons.size()) : neurons.size();
+    createLinks(construction, weights, rewiring, denseThreshold);
+    findSample();
 }
 
-Network::Network(std::map< std::string, size_t > neuronsProportions_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_) :  meanStrength(meanStrength_), meanConnectivity(meanConnectivity_), neuronsProportions(neuronsProportions_), networkModel(networkModel_)
+Network::Network(std::map< std::string, size_t > neuronsProportions_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_, const Communicator* communicator_, PageMode pages, unsigned long int seed, unsigned long int stream, Construction construction, WeightPrecision weights, double rewiring, double denseThreshold) : arena(_ARENA_BLOCK_SIZE_, pages), generator(seed, _STREAMS_*stream), meanStrength(meanStrength_), meanConnectivity(meanConnectivity_), neuronsProportions(neuronsProportions_), networkModel(networkModel_), plasticity(nullptr), stimuli(nullptr), quantized(nullptr), procedural(nullptr), steps(0), integration({ORIGINAL, _INTEGRATION_STEP_, _INTEGRATION_TOLERANCE_}), synapses({INSTANTANEOUS_SYNAPSES, _EXCITATORY_TAU_, _INHIBITORY_TAU_}), excitatoryDecay(0.0), inhibitoryDecay(0.0), evaluations(0), communicator(communicator_), dense(ArenaAllocator<float>(&arena)), constructionBaseline(0), constructionPeak(0)
 {
+    constructionBaseline = residentMemory("VmRSS");
     std::map< std::string, size_t >::iterator p;
+    size_t neuronNumber(0);
+    for (const auto& proportion : neuronsProportions) neuronNumber += proportion.second;
+    neurons.reserve(neuronNumber);
     for(p = neuronsProportions.begin(); p != neuronsProportions.end(); p++) {
         createNeurons(p->second, p->first, delta_);
     }
 
-    for(auto& neuron : neurons) createRandomLinks(neuron);
+    first = communicator ? communicator->first(neurons.size()) : 0;
+    last = communicator ? communicator->last(neurons.size()) : neurons.size();
+    createLinks(construction, weights, rewiring, denseThreshold);
+    findSample();
 }
 
 void Network::createNeurons(size_t neuronNumber, std::string type, double delta)
@@ -28,19 +44,27 @@ void Network::createNeurons(size_t neuronNumber, std::string type, double delta)
     // neurons are created differently if the user use the basic model or the more rational one.
     if(delta==_DELTA_) { //we don't use the rational model
         for (size_t i(0); i<neuronNumber; ++i) {
-            neurons.push_back(new Neurone(type));
+            neurons.push_back(arena.create<Neurone>(type, generator));
         }
     } else {
         for (size_t i(0); i<neuronNumber; ++i) {
-            neurons.push_back(new Neurone(type,delta));
+            neurons.push_back(arena.create<Neurone>(type, delta, generator));
         }
     }
 }
 
 Network::~Network()
 {
+    delete plasticity;
+    plasticity=nullptr;
+    delete stimuli;
+    stimuli=nullptr;
+    delete quantized;
+    quantized=nullptr;
+    delete procedural;
+    procedural=nullptr;
     for(auto& neuron : neurons) {
-        delete neuron;
+        neuron->~Neurone(); // the memory of the neurons and of their links is freed by the arena
         neuron=nullptr;
     }
 }
@@ -50,7 +74,7 @@ std::vector<size_t> Network::RandomIndices(size_t avoidIndice, size_t numberLink
     std::vector<size_t> indicesLinks;
     std::vector<size_t> choseIndices(neurons.size());
     std::iota(choseIndices.begin(), choseIndices.end(),0); // see https://en.cppreference.com/w/cpp/algorithm/iota (the vector will be filled with integrers from 0 until neurons.size())
-    _RNG->shuffle(choseIndices); // mix the vector to randomly chose neurons to link with a given neuron
+    generator.shuffle(choseIndices); // mix the vector to randomly chose neurons to link with a given neuron
 
     choseIndices.erase(std::remove(choseIndices.begin(), choseIndices.end(), avoidIndice), choseIndices.end()); // a neuron can not be linked with itself so we remove its index from the possible links
 
@@ -64,7 +88,7 @@ std::vector<double> Network::RandomStrength (int numberLinks) const
     std::vector<double> strengthLinks(numberLinks);
     double min(0.0);
     double max(2.0*meanStrength);
-    _RNG->uniform_double(strengthLinks,min, max);
+    generator.uniform_double(strengthLinks,min, max);
     return strengthLinks;
 }
 
@@ -73,17 +97,53 @@ void Network::createRandomLinks(Neurone* neuron)
     size_t neuronIndice(findNeuron(neuron));
     if(neuronIndice==neurons.size()) throw std::invalid_argument("The neuron for which you want to create links does not exist in the network.");
 
+    size_t nbLinks(drawDegree());
+
+    std::vector<size_t> indicesLinks=RandomIndices(neuronIndice,nbLinks);
+    std::vector<double> strengthLinks=RandomStrength(indicesLinks.size());
+
+    if(indicesLinks.size()!=strengthLinks.size()) throw std::invalid_argument("The number of links and number of strength are not the same so it is not possible to match a link with a strength. It is not possible to creat the links.");
+
+    if(owns(neuronIndice) and !quantized and dense.empty()) neuron->allocateLinks(indicesLinks.size(), &arena);
+    addLinks(neuronIndice, indicesLinks, strengthLinks);
+}
+
+void Network::addLinks(size_t index, const std::vector<size_t>& indices, const std::vector<double>& strengths)
+{
+    if(!owns(index)) return; // the links were drawn to keep the random sequence, but they are stored by the process which owns the neuron
+
+    if(quantized) {
+        quantized->addNeuron(indices, strengths);
+        return;
+    }
+    if(!dense.empty()) { // the column of the neuron in the matrix, its degree and valence are kept since a column is not contiguous
+        size_t column(index-first), owned(last-first);
+        for(size_t i(0); i<indices.size(); ++i) {
+            float strength(strengths[i]);
+            dense[indices[i]*owned + column] += strength;
+            denseValences[column] += neurons[indices[i]]->getExcitator() ? 0.5*strength : -double(strength);
+        }
+        denseDegrees[column] += indices.size();
+        return;
+    }
+    for(size_t i(0); i<indices.size(); ++i) {
+        neurons[index]->addLink(neurons[indices[i]],strengths[i]);
+    }
+}
+
+size_t Network::drawDegree()
+{
     int nbLinks;
 
     switch (networkModel) {
     case 'B' :
-        nbLinks = _RNG->poisson(meanConnectivity);
+        nbLinks = generator.poisson(meanConnectivity);
         break ;
     case 'C' :
         nbLinks = meanConnectivity;
         break ;
     case 'O' :
-        nbLinks = _RNG->poisson(_RNG->exponential(1.0/meanConnectivity));
+        nbLinks = generator.poisson(generator.exponential(1.0/meanConnectivity));
         break ;
     }
 
@@ -91,14 +151,136 @@ void Network::createRandomLinks(Neurone* neuron)
 
     if (nbLinks<0) throw std::invalid_argument("The number of connections received by a neuron must be positive");
 
-    std::vector<size_t> indicesLinks=RandomIndices(neuronIndice,nbLinks);
-    std::vector<double> strengthLinks=RandomStrength(indicesLinks.size());
+    return nbLinks;
+}
 
-    if(indicesLinks.size()!=strengthLinks.size()) throw std::invalid_argument("The number of links and number of strength are not the same so it is not possible to match a link with a strength. It is not possible to creat the links.");
+size_t Network::expectedLinks() const
+{
+    size_t owned(last-first), most(neurons.size()>0 ? neurons.size()-1 : 0);
+    double degree(std::min<double>(meanConnectivity, most)), variance(0.0);
+    if(networkModel=='C') degree = std::floor(degree);
+    else if(networkModel=='B') variance = degree;
+    else if(networkModel=='O') variance = degree+degree*degree; // poisson law of an exponential mean
+    double links(owned*degree + 5.0*std::sqrt(owned*variance)); // more links than 5 standard deviations above their mean would only reallocate the arrays
+    return std::min<size_t>(std::ceil(links), owned*most);
+}
+
+void Network::streamLinks()
+{
+    std::vector<unsigned int> degrees(neurons.size()); // first pass : the number of links of each neuron and their memory, allocated at once with its exact size
+    size_t owned(0);
+    for(size_t i(0); i<neurons.size(); ++i) {
+        degrees[i] = drawDegree();
+        if(!owns(i)) continue;
+        owned += degrees[i];
+        if(!quantized and dense.empty()) neurons[i]->allocateLinks(degrees[i], &arena);
+    }
+    if(quantized) quantized->reserve(last-first, owned);
+
+    std::vector<size_t> indices; // second pass : the links of each neuron, added directly in their memory
+    std::vector<double> strengths;
+    for(size_t i(0); i<neurons.size(); ++i) {
+        size_t number(degrees[i]), others(neurons.size()-1);
+        indices.clear();
+        if(2*number<=others) { // few links : distinct indices are drawn until there are enough
+            while(indices.size()<number) {
+                size_t sorted(indices.size());
+                for(size_t k(sorted); k<number; ++k) indices.push_back(generator.uniform_int(0, others-1));
+                std::sort(indices.begin()+sorted, indices.end());
+                std::inplace_merge(indices.begin(), indices.begin()+sorted, indices.end());
+                indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+            }
+        } else { // many links : the first ones of a partial shuffle of the other neurons
+            indices.resize(others);
+            std::iota(indices.begin(), indices.end(), 0);
+            for(size_t k(0); k<number; ++k) std::swap(indices[k], indices[generator.uniform_int(k, others-1)]);
+            indices.resize(number);
+        }
+        strengths.clear();
+        for(auto& index : indices) {
+            strengths.push_back(generator.uniform_double(0.0, 2.0*meanStrength));
+            if(index>=i) ++index; // the indices skip the neuron itself
+        }
+        addLinks(i, indices, strengths);
+    }
+}
+
+void Network::topologyLinks(double rewiring)
+{
+    Topology topology(networkModel, neurons.size(), meanConnectivity, rewiring, generator);
+    size_t owned(0);
+    for(size_t i(0); i<neurons.size(); ++i) {
+        if(!owns(i)) continue;
+        owned += topology.getDegree(i);
+        if(!quantized and dense.empty()) neurons[i]->allocateLinks(topology.getDegree(i), &arena);
+    }
+    if(quantized) quantized->reserve(last-first, owned);
+
+    std::vector<size_t> indices;
+    std::vector<double> strengths;
+    for(size_t i(0); i<neurons.size(); ++i) {
+        indices.assign(topology.getSources(i), topology.getSources(i)+topology.getDegree(i));
+        strengths.clear();
+        for(size_t l(0); l<indices.size(); ++l) strengths.push_back(generator.uniform_double(0.0, 2.0*meanStrength)); // drawn by every process, to keep the same random sequence
+        addLinks(i, indices, strengths);
+    }
+}
+
+void Network::createLinks(Construction construction, WeightPrecision weights, double rewiring, double denseThreshold)
+{
+    double density(neurons.size()>1 ? meanConnectivity/(neurons.size()-1) : 0.0);
+    if(construction!=PROCEDURAL_LINKS and weights==DOUBLE_WEIGHTS and neurons.size()>1 and density>=denseThreshold) { // the links are only stored in the matrix, filled by addLinks()
+        size_t owned(last-first);
+        dense.assign(neurons.size()*owned, 0.0f);
+        denseDegrees.assign(owned, 0);
+        denseValences.assign(owned, 0.0);
+        excitation.assign(owned, 0.0);
+        inhibition.assign(owned, 0.0);
+    }
+    if(Topology::isStructured(networkModel)) {
+        if(construction==PROCEDURAL_LINKS) throw std::invalid_argument("The links of the small-world and scale-free networks can not be procedural.");
+        if(weights!=DOUBLE_WEIGHTS) quantized = new QuantizedLinks(weights, &arena);
+        topologyLinks(rewiring);
+        constructionPeak = residentMemory("VmHWM");
+        return;
+    }
+    if(construction==PROCEDURAL_LINKS) {
+        if(weights!=DOUBLE_WEIGHTS) throw std::invalid_argument("The procedural links are not stored, their strengths can not be quantized.");
+        procedural = new ProceduralLinks(neurons.size(), first, generator.getSeed(), generator.getStream(), 2.0*meanStrength);
+        for(size_t i(0); i<neurons.size(); ++i) {
+            size_t degree(drawDegree()); // drawn by every process, to keep the same random sequence
+            if(owns(i)) procedural->addNeuron(degree);
+        }
+        constructionPeak = residentMemory("VmHWM");
+        return;
+    }
+    if(weights!=DOUBLE_WEIGHTS) quantized = new QuantizedLinks(weights, &arena);
+    if(construction==STREAMED_LINKS) streamLinks();
+    else {
+        if(quantized) quantized->reserve(last-first, expectedLinks()); // the degrees are drawn with the links
+        for(auto& neuron : neurons) createRandomLinks(neuron);
+    }
+    constructionPeak = residentMemory("VmHWM");
+}
 
-    for(size_t i(0); i<indicesLinks.size(); ++i) {
-        neuron->addLink(neurons[indicesLinks[i]],strengthLinks[i]);
+size_t Network::residentMemory(const std::string& field)
+{
+    size_t bytes(0);
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line)) {
+        if(line.compare(0, field.size()+1, field + ":")==0) bytes = 1024*std::stoull(line.substr(field.size()+1)); // in kB
     }
+#endif
+    return bytes;
+}
+
+void Network::resetPeakMemory()
+{
+#ifdef __linux__
+    std::ofstream("/proc/self/clear_refs") << "5"; // nothing is done if the kernel does not allow it, the peak is then the one since the start of the process
+#endif
 }
 
 size_t Network::findNeuron(Neurone* neuron) const
@@ -110,18 +292,196 @@ size_t Network::findNeuron(Neurone* neuron) const
     return neurons.size(); //no neuron has the index neurons.size() (possibles indices are from 0 to neurons.size()-1)
 }
 
+std::vector<size_t> Network::selectNeurons(const std::string& selection) const
+{
+    std::vector<size_t> indices;
+    RandomNumbers chooser(generator.getSeed(), generator.getStream()+2); // the random choice does not use the generator of the simulation
+    std::stringstream list(selection);
+    for (std::string element; std::getline(list, element, ','); ) {
+        if (element=="all") {
+            for (size_t i(0); i<neurons.size(); ++i) indices.push_back(i);
+            continue;
+        }
+        size_t colon(element.find(':'));
+        if (colon==std::string::npos) {
+            if (element.empty() or element.find_first_not_of("0123456789")!=std::string::npos) throw std::invalid_argument("The neuron " + element + " is not an index of the network.");
+            size_t index(std::stoul(element));
+            if (index>=neurons.size()) throw std::invalid_argument("The neuron " + element + " is not a neuron of the network.");
+            indices.push_back(index);
+            continue;
+        }
+        std::string what(element.substr(0, colon));
+        std::string number_(element.substr(colon+1));
+        if (number_.empty() or number_.find_first_not_of("0123456789")!=std::string::npos) throw std::invalid_argument("The number of neurons in " + element + " is not valid.");
+        size_t number(std::stoul(number_));
+        if (what=="random") {
+            std::vector<size_t> chosen(neurons.size());
+            std::iota(chosen.begin(), chosen.end(), 0);
+            chooser.shuffle(chosen);
+            chosen.resize(std::min(number, chosen.size()));
+            std::sort(chosen.begin(), chosen.end());
+            indices.insert(indices.end(), chosen.begin(), chosen.end());
+        } else if (NeuronParam.count(what)) {
+            for (size_t i(0); i<neurons.size() and number>0; ++i) {
+                if (neurons[i]->isType(what)) {
+                    indices.push_back(i);
+                    --number;
+                }
+            }
+        } else {
+            throw std::invalid_argument("The neurons " + element + " are not valid (an index, a type followed by a number like RS:3, random followed by a number like random:10, or all).");
+        }
+    }
+    return indices;
+}
+
 void Network::update()
 {
-    for(auto& neuron : neurons) {
-        neuron->computeI();
+    if (!dense.empty()) denseSums();
+    else if (quantized or procedural) {
+        states.resize(neurons.size());
+        for (size_t j(0); j<neurons.size(); ++j) states[j] = neurons[j]->isFiring() ? (neurons[j]->getExcitator() ? 1 : 2) : 0;
+    }
+    if (synapses.model!=INSTANTANEOUS_SYNAPSES) { // contiguous multiplications, vectorized by the compiler
+        for (auto& sum : synapticExcitation) sum *= excitatoryDecay;
+        for (auto& sum : synapticInhibition) sum *= inhibitoryDecay;
+    }
+    for(size_t i(0); i<neurons.size(); ++i) {
+        if(!owns(i)) {
+            generator.normal(0.0,1.0); // same draw as in Neurone::computeI(), the random sequence must stay the same on every process
+            continue;
+        }
+        double sumExcitator, sumInhibitor;
+        if(!dense.empty()) {
+            sumExcitator = excitation[i-first];
+            sumInhibitor = inhibition[i-first];
+        }
+        else if(quantized) quantized->sums(i-first, states, sumExcitator, sumInhibitor);
+        else if(procedural) procedural->sums(i-first, states, sumExcitator, sumInhibitor);
+        else {
+            sumExcitator = neurons[i]->getSumExcitator();
+            sumInhibitor = neurons[i]->getSumInhibitor();
+        }
+        if (synapses.model!=INSTANTANEOUS_SYNAPSES) addSynapticSums(i, sumExcitator, sumInhibitor);
+        neurons[i]->computeI(generator, sumExcitator, sumInhibitor);
+    }
+    if (stimuli) {
+        stimuli->apply(steps+1, input);
+        for(size_t i(first); i<last; ++i) {
+            if (input[i]!=0.0) neurons[i]->setCurrent(neurons[i]->getCurrent()+input[i]);
+        }
     }
 
-    for(auto& neuron : neurons) {
-        neuron->update();
+    for(size_t i(first); i<last; ++i) {
+        evaluations += neurons[i]->update(integration);
+    }
+    ++steps;
+
+    fired.clear();
+    for (size_t i(first); i<last; ++i) {
+        if (neurons[i]->isFiring()) fired.push_back(i);
+    }
+    if (communicator and communicator->getSize()>1) {
+        fired = communicator->allgather(fired);
+        for (size_t i(0); i<neurons.size(); ++i) {
+            if(!owns(i)) neurons[i]->setFiringState(false);
+        }
+        for (auto i : fired) neurons[i]->setFiringState(true);
+    }
+    if (plasticity) plasticity->onSpikes(fired, steps);
+}
+
+void Network::setIntegration(const Integration& integration_)
+{
+    if (integration_.step<=0.0 or integration_.step>_DT_) throw std::invalid_argument("The integration step must be positive and not bigger than the time step.");
+    if (integration_.tolerance<=0.0) throw std::invalid_argument("The tolerance of the adaptive integration must be positive.");
+    integration = integration_;
+}
+
+void Network::setSynapses(const Synapses& synapses_)
+{
+    if (synapses_.excitatoryTau<=0.0 or synapses_.inhibitoryTau<=0.0) throw std::invalid_argument("The decay times of the synapses must be positive.");
+    synapses = synapses_;
+    excitatoryDecay = std::exp(-_DT_/synapses.excitatoryTau);
+    inhibitoryDecay = std::exp(-_DT_/synapses.inhibitoryTau);
+    if (synapses.model==INSTANTANEOUS_SYNAPSES) {
+        std::vector<double>().swap(synapticExcitation);
+        std::vector<double>().swap(synapticInhibition);
+    } else {
+        synapticExcitation.assign(last-first, 0.0);
+        synapticInhibition.assign(last-first, 0.0);
+    }
+}
+
+void Network::addSynapticSums(size_t i, double& sumExcitator, double& sumInhibitor)
+{
+    // the part of the spike added now is the one which makes the total charge (the sum of the decaying current) equal to its strength
+    double& excitatory(synapticExcitation[i-first]);
+    double& inhibitory(synapticInhibition[i-first]);
+    excitatory += (1.0-excitatoryDecay)*sumExcitator;
+    inhibitory += (1.0-inhibitoryDecay)*sumInhibitor;
+    sumExcitator = excitatory;
+    sumInhibitor = inhibitory;
+    if (synapses.model==CONDUCTANCE_SYNAPSES) {
+        double v(std::min<double>(neurons[i]->getPotential(), _T_)); // the overshoot above the threshold is reset at the next update
+        sumExcitator *= (_EXCITATORY_REVERSAL_-v)/(_EXCITATORY_REVERSAL_-_REST_POTENTIAL_);
+        sumInhibitor *= (v-_INHIBITORY_REVERSAL_)/(_REST_POTENTIAL_-_INHIBITORY_REVERSAL_);
+    }
+}
+
+const Synapses& Network::getSynapses() const
+{
+    return synapses;
+}
+
+double Network::getSynapticExcitation(size_t i) const
+{
+    return synapticExcitation.empty() ? 0.0 : synapticExcitation[i-first];
+}
+
+double Network::getSynapticInhibition(size_t i) const
+{
+    return synapticInhibition.empty() ? 0.0 : synapticInhibition[i-first];
+}
+
+Stimuli* Network::enableStimuli()
+{
+    if (!stimuli) {
+        stimuli = new Stimuli(RandomNumbers(generator.getSeed(), generator.getStream()+1));
+        input.assign(neurons.size(), 0.0);
     }
+    return stimuli;
 }
 
-void Network::headerSample(std::ofstream& outfile) const
+void Network::denseSums()
+{
+    firing.clear();
+    for (size_t j(0); j<neurons.size(); ++j) {
+        if (neurons[j]->isFiring()) firing.push_back(j);
+    }
+    size_t owned(last-first);
+    std::fill(excitation.begin(), excitation.end(), 0.0);
+    std::fill(inhibition.begin(), inhibition.end(), 0.0);
+    for (size_t block(0); block<owned; block+=_DENSE_BLOCK_) { // the sums of a block of neurons stay in the cache while the rows of all the firing neurons are added
+        size_t end(std::min<size_t>(block+_DENSE_BLOCK_, owned));
+        for (auto j : firing) {
+            const float* strengths(&dense[j*owned]);
+            double* sums(neurons[j]->getExcitator() ? excitation.data() : inhibition.data());
+            for (size_t r(block); r<end; ++r) sums[r] += strengths[r];
+        }
+    }
+}
+
+void Network::enablePlasticity(double aPlus, double aMinus, double tauPlus, double tauMinus)
+{
+    if (quantized) throw std::invalid_argument("The plasticity needs the strengths of the links in double precision, it can not be used with quantized links.");
+    if (procedural) throw std::invalid_argument("The plasticity needs stored links, it can not be used with procedural links.");
+    if (!dense.empty()) throw std::invalid_argument("The plasticity needs the links of the neurons, it can not be used with the dense matrix of the links (give a dense threshold above 1).");
+    delete plasticity;
+    plasticity = new Plasticity(neurons, 2.0*meanStrength, aPlus, aMinus, tauPlus, tauMinus);
+}
+
+void Network::headerSample(std::ostream& outfile) const
 {
     for(const auto& proportions : neuronsProportions) {
         outfile << "\t" << proportions.first << ".v\t" << proportions.first << ".u\t" << proportions.first << ".I";
@@ -129,38 +489,121 @@ void Network::headerSample(std::ofstream& outfile) const
     outfile << std::endl;
 }
 
-void Network::headerParameters(std::ofstream& outfile) const
+void Network::headerParameters(std::ostream& outfile) const
 {
     outfile << "Type\ta\tb\tc\td\tInhibitory\tdegree\tvalence" << std::endl;
 }
 
-void Network::printSpikes(std::ostream& outfile, size_t time) const
+void Network::headerSpikes(std::ostream& outfile, SpikesFormat format) const
 {
-    outfile << time;
-    for (const auto& neuron : neurons)
-        outfile << " " << neuron->isFiring();
-    outfile << std::endl;
+    if (format==EVENT_SPIKES) outfile << "# spikes of " << neurons.size() << " neurons : time neuron\n";
+    if (format==ID_SPIKES) outfile << "# spikes of " << neurons.size() << " neurons : time ids\n";
 }
 
-void Network::printParameters (std::ofstream& outfile) const
+void Network::printSpikes(std::ostream& outfile, size_t time, SpikesFormat format) const
 {
-    for(const auto& neuron : neurons) {
-        neuron->printParams(outfile);
+    TextBuffer text(format==RASTER_SPIKES ? 2*neurons.size()+24 : 24*fired.size()+24);
+    printSpikes(text, time, format);
+    text.write(outfile);
+}
+
+void Network::printSpikes(TextBuffer& text, size_t time, SpikesFormat format) const
+{
+    switch (format) {
+    case RASTER_SPIKES :
+        text << time;
+        for (const auto& neuron : neurons)
+            text << ' ' << neuron->isFiring();
+        text << '\n';
+        break;
+    case EVENT_SPIKES :
+        for (auto i : fired) text << time << ' ' << i << '\n';
+        break;
+    case ID_SPIKES :
+        text << time;
+        for (auto i : fired) text << ' ' << i;
+        text << '\n';
+        break;
     }
 }
 
-void Network::printSample(std::ofstream& outfile, size_t time) const
+void Network::printParameters (std::ostream& outfile) const
+{
+    ParameterColumns(*this, communicator).print(outfile); //each process fills the parameters of its neurons, the rank 0 gathers them in the neurons order
+}
+
+void Network::findSample()
 {
-    outfile << time;
+    sample.clear();
     for (const auto& proportions : neuronsProportions) {
-        for (const auto& neuron : neurons) {
-            if (neuron->isType(proportions.first)) { //we print one neuron per type
-                neuron->printSample(outfile); //this will always be the same neuron to be printed as soon as the neurons order in the neuron vector doesn't change
-                break; //We exit the for as soon as we print a neuron because we only want to print one per type
+        for (size_t i(0); i<neurons.size(); ++i) {
+            if (neurons[i]->isType(proportions.first)) { //we print one neuron per type
+                sample.push_back(i); //this will always be the same neuron to be printed as soon as the neurons order in the neuron vector doesn't change
+                break;
             }
         }
     }
-    outfile << std::endl;
+    sampleValues.assign(3*sample.size(), 0.0);
+}
+
+void Network::printSample(std::ostream& outfile, size_t time) const
+{
+    TextBuffer text(48*sample.size()+24);
+    printSample(text, time);
+    text.write(outfile);
+}
+
+void Network::printSample(TextBuffer& text, size_t time) const
+{
+    for (size_t s(0); s<sample.size(); ++s) {
+        size_t i(sample[s]);
+        bool owned(owns(i)); //the values are added by the process which owns the neuron
+        sampleValues[3*s] = owned ? neurons[i]->getPotential() : 0.0;
+        sampleValues[3*s+1] = owned ? neurons[i]->getRelaxation() : 0.0;
+        sampleValues[3*s+2] = owned ? neurons[i]->getCurrent() : 0.0;
+    }
+    if (communicator) {
+        communicator->sum(sampleValues);
+        if (!communicator->isRoot()) return;
+    }
+
+    text << time;
+    for (const auto& value : sampleValues) text << '\t' << value;
+    text << '\n';
+}
+
+void Network::printMemory(std::ostream& outfile) const
+{
+    const std::vector<std::string> names{"normal", "transparent", "explicit"};
+    std::ostringstream local;
+    if (communicator and communicator->getSize()>1) local << "rank " << communicator->getRank() << " : ";
+    local << "neurons and links : " << arena.getUsed()/1048576.0 << " MiB used in " << arena.getReserved()/1048576.0 << " MiB of " << names[arena.getPages()] << " pages, " << arena.getHugePages()/1048576.0 << " MiB in huge pages";
+    for (const auto& node : arena.getNodes()) {
+        if (node.first<0) local << ", " << node.second << " pages not in memory";
+        else local << ", " << node.second << " pages on NUMA node " << node.first;
+    }
+    local << "\n";
+    if (communicator and communicator->getSize()>1) local << "rank " << communicator->getRank() << " : ";
+    local << "construction : peak resident memory " << constructionPeak/1048576.0 << " MiB, " << constructionBaseline/1048576.0 << " MiB before the construction";
+    if (!dense.empty()) local << ", dense matrix of the links : " << dense.size()*sizeof(float)/1048576.0 << " MiB";
+    local << "\n";
+    if (quantized) {
+        double rounding(0.0);
+        for (size_t i(0); i<quantized->getNumberNeurons(); ++i) rounding = std::max(rounding, 0.5*quantized->getScale(i));
+        if (communicator and communicator->getSize()>1) local << "rank " << communicator->getRank() << " : ";
+        local << "quantized links : " << quantized->getNumberLinks() << " links in " << quantized->getMemory()/1048576.0 << " MiB (" << (quantized->getPrecision()==SHORT_WEIGHTS ? 16 : 8) << " bits strengths), largest rounding of a strength " << rounding << "\n";
+    }
+    if (procedural) {
+        if (communicator and communicator->getSize()>1) local << "rank " << communicator->getRank() << " : ";
+        local << "procedural links : " << procedural->getNumberLinks() << " links computed at each time step, " << procedural->getMemory()/1048576.0 << " MiB of numbers of links\n";
+    }
+
+    if (communicator and communicator->getSize()>1) {
+        std::string all(communicator->gather(local.str()));
+        if (communicator->isRoot()) outfile << all;
+        return;
+    }
+    outfile << local.str();
 }
 
 size_t Network::getNumberNeurons() const
@@ -183,7 +626,93 @@ double Network::getExcitatoryProportion() const
     return excitatoryProportion;
 }
 
-Neurons Network::getNeurons() const
+const Neurons& Network::getNeurons() const
 {
     return neurons;
 }
+
+View<Neurone*> Network::getOwnedNeurons() const
+{
+    return View<Neurone*>(neurons.data()+first, last-first);
+}
+
+Plasticity* Network::getPlasticity() const
+{
+    return plasticity;
+}
+
+Stimuli* Network::getStimuli() const
+{
+    return stimuli;
+}
+
+bool Network::owns(size_t index) const
+{
+    return index>=first and index<last;
+}
+
+size_t Network::getEvaluations() const
+{
+    return evaluations;
+}
+
+const RandomNumbers& Network::getGenerator() const
+{
+    return generator;
+}
+
+const std::vector<size_t>& Network::getFired() const
+{
+    return fired;
+}
+
+std::vector<bool> Network::getFiring() const
+{
+    std::vector<bool> firing(neurons.size(), false);
+    for (auto i : fired) firing[i] = true;
+    return firing;
+}
+
+bool Network::hasDenseLinks() const
+{
+    return !dense.empty();
+}
+
+const QuantizedLinks* Network::getQuantizedLinks() const
+{
+    return quantized;
+}
+
+const ProceduralLinks* Network::getProceduralLinks() const
+{
+    return procedural;
+}
+
+size_t Network::getDegree(size_t index) const
+{
+    if (quantized and owns(index)) return quantized->getNumberLinks(index-first);
+    if (!dense.empty() and owns(index)) return denseDegrees[index-first];
+    if (procedural and owns(index)) return procedural->getNumberLinks(index-first);
+    return neurons[index]->getSizeNeighborhood();
+}
+
+double Network::getValence(size_t index) const
+{
+    if (!dense.empty() and owns(index)) return denseValences[index-first];
+    double valence(0.0);
+    forEachLink(index, [&valence](const Neurone* source, double strength) {
+        if (source->getExcitator()) valence += 0.5*strength;
+        else valence -= strength;
+    });
+    return valence;
+}
+
+size_t Network::getConstructionMemory() const
+{
+    return constructionPeak>constructionBaseline ? constructionPeak-constructionBaseline : 0;
+}
+
+const std::map< std::string, size_t >& Network::getNeuronsProportions() const
+{
+    return neuronsProportions;
+}
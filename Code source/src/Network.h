@@ -1,10 +1,19 @@
+#pragma once
 #include "Neurone.h"
+#include "Plasticity.h"
+#include "Communicator.h"
+#include "Stimuli.h"
+#include "Random.h"
+#include "TextBuffer.h"
+#include "QuantizedLinks.h"
+#include "ProceduralLinks.h"
 
 /*! @class Network
 
  A Network represents the environment in which each  \ref Neurone evolve.
  A Network is a set of \ref Neuron which models how they interact and how the connections between them influence their behaviour. Each neuron is connected to other neurons by a link with a certain intensity. The network makes it possible to generate these links randomly when constructing its neurons. The number of links depends on the mode chosen by the user : constant (each neurons has the same number of connections), random near a mean or overdispersed. The links a neuron has with others are found in the class \ref Neurone. Each neuron knows all the neurons it is connected with and these links are unidirectional and unique (if neuron 1 is linked to neuron 2, neuron 2 is not necessary linked to neuron 1 and neuron 1 can not have more than 1 links with neuron 2).
  Each neuron in the network is associated with an index in the network's neuron set and can thus be found in the network thanks to it.
+ The neurons and their links are allocated in an \ref Arena : the number of links of a neuron is drawn before they are created, so its list of links is allocated once, with the exact size.
  The dynamic of the network is such that it updates each of its neurons at each time step.
  The neuron's state (firing or not) and parameters can be printed on three output files to be studied.
  */
@@ -25,11 +34,19 @@ public:
         \param meanStrength_ (double) : average strength of a link between two neurons.
         \param neuronsProportions_ (map<string,size_t>) : number of each neuron type (5 possible types : RS, FS, CH, IB, LTS)
         \param delta_ (double) : parameter to compute the noise in one additional fonctionality of the program.
-        \param networkModel_ (char) : specify the distribution of the number of links (constant, random near a mean or overdispersed).
+        \param networkModel_ (char) : specify the distribution of the number of links (constant, random near a mean or overdispersed), or a structured network (small-world or scale-free, see \ref Topology).
+        \param communicator_ (Communicator*) : in the distributed mode, tells which neurons are owned by this process (see \ref Communicator). Every process creates all the neurons (they are light) and makes all the random draws in the same order, but only stores the links received by the neurons it owns, so that the network is exactly the same as in a single process run. By default (nullptr), all the neurons are owned.
+        \param pages (PageMode) : memory pages of the neurons and links (see \ref Arena).
+        \param seed (unsigned long int) : seed of the random generators of the network (0 : a random seed).
+        \param stream (unsigned long int) : index of the network among the ones using the same seed. The network draws its neurons, its links and the noise of each time step from the random stream \ref _STREAMS_ * stream of the seed, the Poisson stimuli from the next stream and the random choices of neurons (*selectNeurons()*) from the following one (see \ref RandomNumbers). Each network only uses its own generators, so several networks can be simulated at the same time in different threads.
+        \param construction (Construction) : how the links are drawn. With SHUFFLED_LINKS, all the neurons are shuffled to choose the links of each neuron (*createRandomLinks()*), which takes a temporary memory and a time proportional to the number of neurons for each neuron. With STREAMED_LINKS (*streamLinks()*), the number of links of every neuron is drawn first and their memory is allocated with its exact size, then the links of each neuron are drawn directly in it : the only temporary memory is the list of the indices of the links of one neuron, so the peak memory of the construction stays close to the memory of the final network (see *printMemory()*). With PROCEDURAL_LINKS, only the number of links of every neuron is drawn, and the links received by the owned neurons are computed again from the seed at each update (see \ref ProceduralLinks) : the memory of the links is 4 bytes per neuron, the synaptic currents take more computation. The three constructions give different networks with the same statistics.
+        \param weights (WeightPrecision) : with DOUBLE_WEIGHTS, the links are stored in the neurons. Otherwise, the links received by the owned neurons are stored in a \ref QuantizedLinks, with their strengths rounded to integers of 16 or 8 bits, and the neurons have no links : the network is the same, up to the rounding of the strengths, in about a third of the memory, and *update()* reads three times less memory to compute the synaptic currents. The plasticity can not be used with quantized links, and the procedural links can not be quantized (std::invalid_argument is thrown).
+        \param rewiring (double) : rewiring probability of the small-world model. The links of the small-world and scale-free models are drawn by a \ref Topology whatever the construction, except PROCEDURAL_LINKS which can not give them (std::invalid_argument is thrown).
+        \param denseThreshold (double) : if the density of the links (meanConnectivity / (number of neurons - 1)) is at least this threshold, and the links are neither quantized nor procedural, the links received by the owned neurons are stored in a dense matrix instead of the neurons (see *hasDenseLinks()*).
      */
 ///@{
-    Network(size_t neuronNumber, double excitatoryProportion_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_);
-    Network(std::map< std::string, size_t > neuronsProportions_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_);
+    Network(size_t neuronNumber, double excitatoryProportion_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_, const Communicator* communicator_=nullptr, PageMode pages=NORMAL_PAGES, unsigned long int seed=_SEED_, unsigned long int stream=0, Construction construction=SHUFFLED_LINKS, WeightPrecision weights=DOUBLE_WEIGHTS, double rewiring=_REWIRING_, double denseThreshold=_DENSE_THRESHOLD_);
+    Network(std::map< std::string, size_t > neuronsProportions_, double meanConnectivity_, double meanStrength_, double delta_, char networkModel_, const Communicator* communicator_=nullptr, PageMode pages=NORMAL_PAGES, unsigned long int seed=_SEED_, unsigned long int stream=0, Construction construction=SHUFFLED_LINKS, WeightPrecision weights=DOUBLE_WEIGHTS, double rewiring=_REWIRING_, double denseThreshold=_DENSE_THRESHOLD_);
     void createNeurons(size_t neuronNumber, std::string type, double delta);
     ~Network();
 ///@}
@@ -45,6 +62,8 @@ public:
 
         - In the overdispersed model, every neuron has a different mean of connections (chosen by an exponential distribution). The connections are then built as the original model.
 
+        The small-world ('W') and scale-free ('A') models are not drawn neuron by neuron : their links are drawn all at once by a \ref Topology, then *topologyLinks()* allocates the links of each neuron with their exact size and draws their strengths as in the original model.
+
        \param neuron (Neurone*) : neuron whose links we want to create.
        \param avoidIndice (size_t) : index of the neuron whose links are created in the network's neuron set. This index can't be added to the link table because a neuron can't be linked to itself.
        \param numberLinks (int) : number of connections received by a neurons.
@@ -53,46 +72,89 @@ public:
     std::vector<size_t> RandomIndices(size_t avoidIndice, size_t numberLinks);
     std::vector<double> RandomStrength (int numberLinks) const;
     void createRandomLinks(Neurone* neuron);
+    void streamLinks();
+    void topologyLinks(double rewiring);
 
     /*!
        \param neuron (Neurone*) : neuron sought in the whole network.
        \return if the neuron is found, returns its index in the set. If not, return the size of the set (no neuron has the size of the set as an index since indexes go from 0 to size-1).
     */
     size_t findNeuron(Neurone* neuron) const;
+    /*!
+       @brief Find the indices of a list of neurons given by the user (probes, targets of the stimuli), separated by commas. Each element is either :
+       - an index in the network, for example \b 17,
+       - a type followed by a number of neurons, for example \b RS:3 (the 3 first RS neurons),
+       - \b random followed by a number of neurons, for example \b random:10 (10 neurons chosen at random, with a random stream of their own so that the simulation is not modified),
+       - \b all (every neuron of the network).
+       \param selection (string) : the list of neurons.
+       \return the indices of the neurons, in the order of the list.
+    */
+    std::vector<size_t> selectNeurons(const std::string& selection) const;
 ///@}
 
     /*!
-       @brief Computes each neuron current via \ref Neurone::computeI() and updates them with it at each time step using \ref Neurone::update().
+       @brief Computes each neuron current via \ref Neurone::computeI(), adds the external current of the stimuli if any, and updates them with it at each time step using \ref Neurone::update(). With decaying synapses (see *setSynapses()*), the sums of the links given to \ref Neurone::computeI() are the decaying sums of the neuron.
+       In the distributed mode, only the owned neurons are updated (the noise of the other ones is still drawn to keep the same random sequence on every process), then the indices of the neurons which fired are exchanged between the processes (\ref Communicator::allgather()) to update the firing state of the neurons owned by the others.
     */
     void update();
 
+    /*!
+       @brief *setIntegration()* chooses the numerical scheme used by \ref Neurone::update() (by default, the ORIGINAL scheme with two half-steps).
+       Enable the spike-timing-dependent plasticity (see \ref Plasticity) of the links of the network. Once enabled, each call to *update()* also updates the strength of the links of the neurons that fired. The strength of a link stays between 0 and 2*meanStrength (the maximal strength of a link at its creation).
+    */
+    void setIntegration(const Integration& integration_);
+    /*!
+       @brief *setSynapses()* chooses the time course of the synaptic currents (by default, INSTANTANEOUS_SYNAPSES, see \ref SynapseModel). With the decaying synapses, each owned neuron has one excitatory and one inhibitory sum, which decay by exp(-dt/tau) at each update and receive the sums of the links from the neurons which fired : a spike is added once to the neuron it reaches, whatever its number of links.
+       Throws std::invalid_argument if a decay time is not positive.
+    */
+    void setSynapses(const Synapses& synapses_);
+    /*!
+       @brief *enableStimuli()* gives the external currents injected in the neurons (see \ref Stimuli), created empty the first time. At each update, the current of the active stimuli is added to the current computed by \ref Neurone::computeI().
+    */
+    Stimuli* enableStimuli();
+    /// throws std::invalid_argument with quantized, procedural or dense links
+    void enablePlasticity(double aPlus=_STDP_A_PLUS_, double aMinus=_STDP_A_MINUS_, double tauPlus=_STDP_TAU_PLUS_, double tauMinus=_STDP_TAU_MINUS_);
+
 
     /*!@name Display all the results in different output file.
        \param outfile (ostream&) : the name of the output file to write the spikes results on.
-       \param outfile (ofstream&) : the name of the output file to write the parameters or the neuron sample on.
+       \param outfile (ostream&) : the name of the output file to write the parameters or the neuron sample on (a std::ofstream or a \ref CompressedOutput).
        \param time (size_t) : the moment of the simulation to consider
     */
 ///@{
     /*!
        @brief Writes the header of the sample file  in order to make it easier to understand to what the values in the files correspond to.
     */
-    void headerSample(std::ofstream& outfile) const;
+    void headerSample(std::ostream& outfile) const;
     /*!
        @brief Writes the header of the parameters file  in order to make it easier to understand to what the values in the files correspond to.
     */
-    void headerParameters(std::ofstream& outfile) const;
+    void headerParameters(std::ostream& outfile) const;
+    /*!
+       @brief Writes the header of the spikes file : nothing for the raster, a comment line with the number of neurons for the events and the ids.
+    */
+    void headerSpikes(std::ostream& outfile, SpikesFormat format=RASTER_SPIKES) const;
     /*!
        @brief Writes  the state of each neuron as spikes (firing=1 or not fring=0) in the output file which name has the suffix _spikes.
+       With the events or ids \ref SpikesFormat, only the neurons which fired during the last update (*getFired()*) are written, so the size of the file is proportional to the number of spikes instead of the number of neurons times the duration.
+       *printSpikes()* and *printSample()* can also add their line to a \ref TextBuffer, written later in the file with the lines of other time steps.
     */
-    void printSpikes(std::ostream& outfile, size_t time) const;
+    void printSpikes(std::ostream& outfile, size_t time, SpikesFormat format=RASTER_SPIKES) const;
+    void printSpikes(TextBuffer& text, size_t time, SpikesFormat format=RASTER_SPIKES) const;
     /*!
-       @brief Calls \ref Neurone::printParams() to write all the \ref Neurone parameters : type, a , b, c, d, excitator, degree (number of connections), valence (\ref Neurone::getValence()) in one output file which name has the suffix _parameters.
+       @brief In the distributed mode, this method and *printSample()* must be called by all the processes, but only the rank 0 writes in the file.
+       Writes all the \ref Neurone parameters : type, a , b, c, d, excitator, degree (number of connections), valence (\ref Neurone::getValence()) in one output file which name has the suffix _parameters, as \ref Neurone::printParams() would (see \ref ParameterColumns, which also writes them in binary columns).
     */
-    void printParameters(std::ofstream& outfile) const;
+    void printParameters(std::ostream& outfile) const;
     /*!
-       @brief Chose one neurone of each type present in the simulation and calls \ref Neurone::printSample() to write the \ref Neurone parameters : v, u, I in the output file which name  has the suffix _sample_neurons).
+       @brief Writes the \ref Neurone parameters : v, u, I of one neurone of each type present in the simulation (the first one of each type, found once for all when the network is built) in the output file which name  has the suffix _sample_neurons).
     */
-    void printSample(std::ofstream& outfile, size_t time) const;
+    void printSample(std::ostream& outfile, size_t time) const;
+    void printSample(TextBuffer& text, size_t time) const;
+    /*!
+       @brief Writes the memory used by the neurons and links, the part of it in huge pages and the number of memory pages on each NUMA node (see \ref Arena), the memory of the quantized links and the largest rounding of their strengths or the memory of the procedural links if any, then the peak of the resident memory of the process during the construction, compared to the resident memory before it (read in /proc/self/status, Linux only). In the distributed mode, each process reports its own memory.
+    */
+    void printMemory(std::ostream& outfile) const;
 ///@}
 
     /*!
@@ -103,14 +165,127 @@ public:
     double getMeanStrength()const;
     double getMeanConnectivity()const;
     double getExcitatoryProportion()const;
-    Neurons getNeurons() const;
+    /// the neurons of the whole network, without copy (the vector is never reallocated once the network is built)
+    const Neurons& getNeurons() const;
+    /// the neurons owned by this process (all the neurons in a single process run), without copy
+    View<Neurone*> getOwnedNeurons() const;
+    Plasticity* getPlasticity() const;
+    Stimuli* getStimuli() const;
+    bool owns(size_t index) const;
+    size_t getEvaluations() const;
+    const RandomNumbers& getGenerator() const;
+    const Synapses& getSynapses() const;
+    /// decaying excitatory and inhibitory sums of an owned neuron (0 with the instantaneous synapses)
+    double getSynapticExcitation(size_t index) const;
+    double getSynapticInhibition(size_t index) const;
+    /*! @brief *hasDenseLinks()* tells if the links received by the owned neurons are stored in a dense matrix (one row of single precision strengths per presynaptic neuron, 0 without link) instead of the neurons, which then have no links. *update()* computes the synaptic current of the owned neurons by adding the row of each firing neuron to the sums of the excitatory or inhibitory links, by blocks of \ref _DENSE_BLOCK_ neurons which stay in the cache : contiguous additions, vectorized by the compiler, instead of following the pointers of the links of each neuron.
+        The matrix is allocated in the \ref Arena and takes 4 bytes per pair of neurons, against 16 bytes per link in the neurons : above the default density \ref _DENSE_THRESHOLD_, it takes less memory. The strengths are rounded to single precision and the sums are made in a different order, so the currents can differ from the ones of \ref Neurone::computeI() by a relative 1e-7. The plasticity can not be used with the dense matrix.
+    */
+    bool hasDenseLinks() const;
+    /// quantized or procedural links of the owned neurons, nullptr if the links are stored in the neurons
+    const QuantizedLinks* getQuantizedLinks() const;
+    const ProceduralLinks* getProceduralLinks() const;
+    /// number of links received by an owned neuron and their valence (see \ref Neurone::getValence()), from the neuron, the quantized or the procedural links
+    size_t getDegree(size_t index) const;
+    double getValence(size_t index) const;
+    /// indices (in increasing order) of the neurons which fired during the last update, in the whole network
+    const std::vector<size_t>& getFired() const;
+    /// firing state of each neuron during the last update (bitset of the whole network, a new vector at each call : *getFired()* or \ref Neurone::isFiring() do not copy)
+    std::vector<bool> getFiring() const;
+    /*! @brief *forEachLink()* calls function(source, strength) for each link received by a neuron (source is a const Neurone*; only the owned neurons have links), whatever the storage of the links (in the neuron, quantized, procedural or in the dense matrix, whose column is read in the order of the neurons), without copying them.
+    */
+    template<class Function>
+    void forEachLink(size_t index, Function function) const;
+    const std::map< std::string, size_t >& getNeuronsProportions() const;
+    /// increase of the resident memory of the process from before the construction to its peak at the end of the construction, in bytes (0 if unknown). The peak is the one since the last *resetPeakMemory()*, or since the start of the process.
+    size_t getConstructionMemory() const;
+    /// resident memory of the process (field VmRSS) or its peak (VmHWM) in /proc/self/status, in bytes (0 if unknown)
+    static size_t residentMemory(const std::string& field);
+    /// the peak of the resident memory of the whole process starts again from the current resident memory (Linux only) : the network never does it, the program which reports the construction calls it before building the network (see \ref Simulation)
+    static void resetPeakMemory();
 ///@}
 
 private :
+    /// find the first neuron of each type, written by printSample()
+    void findSample();
+    /// sums of the strengths of the links from the firing excitatory and inhibitory neurons to each owned neuron, with the dense matrix
+    void denseSums();
+    /// add the sums of the links of an owned neuron to its decaying sums, and replace them by the currents of the synapses
+    void addSynapticSums(size_t index, double& sumExcitator, double& sumInhibitor);
+    /// draw the number of links received by a neuron, according to the network model
+    size_t drawDegree();
+    /// number of links of the owned neurons large enough for the shuffled construction, which draws the degrees with the links : exact with a constant degree, the mean and 5 standard deviations otherwise
+    size_t expectedLinks() const;
+    /// create the links of every neuron and measure the memory of the construction
+    void createLinks(Construction construction, WeightPrecision weights, double rewiring, double denseThreshold);
+    /// store the links drawn for a neuron in the neuron (its memory is already allocated) or in the quantized links, if it is owned
+    void addLinks(size_t index, const std::vector<size_t>& indices, const std::vector<double>& strengths);
+
+    ///memory of the neurons and of their links, freed all at once with the network
+    Arena arena;
+    ///random generator of the construction and of the updates (mutable : RandomStrength() draws numbers)
+    mutable RandomNumbers generator;
     Neurons neurons;
     double meanStrength;
     double meanConnectivity;
     double excitatoryProportion;
     std::map< std::string, size_t > neuronsProportions;
     char networkModel;
+    ///nullptr if the links are not plastic
+    Plasticity* plasticity;
+    ///nullptr if no external current is injected
+    Stimuli* stimuli;
+    ///nullptr if the links are stored in the neurons
+    QuantizedLinks* quantized;
+    ProceduralLinks* procedural;
+    ///state of each neuron for the quantized and procedural links (0 : not firing, 1 : firing excitatory, 2 : firing inhibitory)
+    std::vector<uint8_t> states;
+    ///number of calls to update()
+    size_t steps;
+    std::vector<size_t> fired;
+    std::vector<size_t> sample;
+    ///v, u and I of each neuron of the sample, written by printSample() at each time step without allocation (mutable : printSample() is const)
+    mutable std::vector<double> sampleValues;
+    ///external current of each neuron at the current time step
+    std::vector<double> input;
+    Integration integration;
+    Synapses synapses;
+    ///factor exp(-dt/tau) applied at each update to the excitatory and inhibitory sums of the decaying synapses
+    double excitatoryDecay, inhibitoryDecay;
+    ///decaying excitatory and inhibitory sums of each owned neuron, empty with the instantaneous synapses
+    std::vector<double> synapticExcitation, synapticInhibition;
+    ///total number of evaluations of the membrane potential equation made by the neurons
+    size_t evaluations;
+    ///nullptr in a single process run
+    const Communicator* communicator;
+    ///the neurons owned by this process are the ones with an index from first to last-1
+    size_t first, last;
+    ///strength of the link from each neuron (row) to each owned neuron (column) in the arena, empty if the links are not stored in a dense matrix
+    std::vector<float, ArenaAllocator<float> > dense;
+    ///number of links and valence of each owned neuron with the dense matrix, whose columns are not contiguous
+    std::vector<size_t> denseDegrees;
+    std::vector<double> denseValences;
+    ///sums of the links from the firing excitatory and inhibitory neurons to each owned neuron, and indices of the firing neurons
+    std::vector<double> excitation, inhibition;
+    std::vector<size_t> firing;
+    ///resident memory of the process before the construction and its peak during the construction, in bytes (0 if unknown)
+    size_t constructionBaseline, constructionPeak;
 };
+
+template<class Function>
+void Network::forEachLink(size_t index, Function function) const
+{
+    if (quantized and owns(index)) {
+        for (size_t k(0); k<quantized->getNumberLinks(index-first); ++k) function(static_cast<const Neurone*>(neurons[quantized->getSource(index-first, k)]), quantized->getStrength(index-first, k));
+    } else if (procedural and owns(index)) {
+        for (size_t k(0); k<procedural->getNumberLinks(index-first); ++k) function(static_cast<const Neurone*>(neurons[procedural->getSource(index-first, k)]), procedural->getStrength(index-first, k));
+    } else if (!dense.empty() and owns(index)) {
+        size_t owned(last-first);
+        for (size_t j(0); j<neurons.size(); ++j) {
+            float strength(dense[j*owned + index-first]);
+            if (strength!=0.0f) function(static_cast<const Neurone*>(neurons[j]), double(strength));
+        }
+    } else {
+        for (const auto& link : neurons[index]->getLinks()) function(static_cast<const Neurone*>(link.neurone), link.bondStrength);
+    }
+}
@@ -1,9 +1,9 @@
 #include "Neurone.h"
 #include "Random.h"
 
-Neurone::Neurone(std::string chosen_type) : type(chosen_type)
+Neurone::Neurone(std::string chosen_type, RandomNumbers& generator) : type(chosen_type)
 {
-    double r(_RNG->uniform_double(0.0,1.0));
+    double r(generator.uniform_double(0.0,1.0));
     initialize(type);
     if (chosen_type == "FS") {
         a *= (1-0.8*r);
@@ -16,20 +16,20 @@ Neurone::Neurone(std::string chosen_type) : type(chosen_type)
     v = -65.0;
     u = b*v;
     firing = false;
-    I = w*_RNG->normal(0.0,1.0);
+    I = w*generator.normal(0.0,1.0);
 }
 
-Neurone::Neurone(std::string chosen_type, double delta) : type(chosen_type)
+Neurone::Neurone(std::string chosen_type, double delta, RandomNumbers& generator) : type(chosen_type)
 {
     v = -65.0;
     initialize(type);
-    a*= deltaFactor(delta);
-    b*= deltaFactor(delta);
-    c*= deltaFactor(delta);
-    d*= deltaFactor(delta);
+    a*= deltaFactor(delta, generator);
+    b*= deltaFactor(delta, generator);
+    c*= deltaFactor(delta, generator);
+    d*= deltaFactor(delta, generator);
     u = b*v;
     firing = false;
-    I = w*_RNG->normal(0.0,1.0);
+    I = w*generator.normal(0.0,1.0);
 }
 
 Neurone::~Neurone() {}
@@ -46,9 +46,9 @@ void Neurone::initialize(std::string type)
     excitator=parameters.exci;
 }
 
-double Neurone::deltaFactor(double delta)
+double Neurone::deltaFactor(double delta, RandomNumbers& generator)
 {
-    return _RNG->uniform_double(1-delta,1+delta);
+    return generator.uniform_double(1-delta,1+delta);
 }
 
 void Neurone::addLink(Neurone* neurone, double strength)
@@ -57,7 +57,20 @@ void Neurone::addLink(Neurone* neurone, double strength)
     neighborhood.push_back(new_link);
 }
 
+void Neurone::allocateLinks(size_t number, Arena* arena)
+{
+    Links links{ArenaAllocator<NeuroneInteraction>(arena)};
+    links.reserve(std::max(number, neighborhood.size()));
+    links.insert(links.end(), neighborhood.begin(), neighborhood.end());
+    neighborhood = std::move(links);
+}
+
 void Neurone::update()
+{
+    update({ORIGINAL, _INTEGRATION_STEP_, _INTEGRATION_TOLERANCE_});
+}
+
+size_t Neurone::update(const Integration& integration)
 {
     if (v > _T_) {
         firing = true;
@@ -67,16 +80,104 @@ void Neurone::update()
     if (firing) {
         v = c;
         u += d;
-    } else {
+        return 0;
+    }
+
+    if (integration.method==ORIGINAL) {
         v += 0.5*(0.04*v*v + 5.0*v + 140.0 - u + I);
         v += 0.5*(0.04*v*v + 5.0*v + 140.0 - u + I);
         u += a*(b*v-u);
+        return 2;
+    }
+    if (integration.method==ADAPTIVE) return adaptiveStep(integration);
+
+    size_t steps(std::max(1.0, std::round(_DT_/integration.step))); // the time step is divided in equal sub-steps
+    double h(double(_DT_)/steps);
+    size_t evaluations(0);
+    for (size_t i(0); i<steps; ++i) {
+        switch (integration.method) {
+        case EULER : {
+            double kv(dv(v,u)), ku(du(v,u));
+            v += h*kv;
+            u += h*ku;
+            evaluations += 1;
+            break;
+        }
+        case RK2 : {
+            double kv1(dv(v,u)), ku1(du(v,u));
+            double kv2(dv(v+h*kv1,u+h*ku1)), ku2(du(v+h*kv1,u+h*ku1));
+            v += 0.5*h*(kv1+kv2);
+            u += 0.5*h*(ku1+ku2);
+            evaluations += 2;
+            break;
+        }
+        case RK4 : {
+            double kv1(dv(v,u)), ku1(du(v,u));
+            double kv2(dv(v+0.5*h*kv1,u+0.5*h*ku1)), ku2(du(v+0.5*h*kv1,u+0.5*h*ku1));
+            double kv3(dv(v+0.5*h*kv2,u+0.5*h*ku2)), ku3(du(v+0.5*h*kv2,u+0.5*h*ku2));
+            double kv4(dv(v+h*kv3,u+h*ku3)), ku4(du(v+h*kv3,u+h*ku3));
+            v += h*(kv1+2.0*kv2+2.0*kv3+kv4)/6.0;
+            u += h*(ku1+2.0*ku2+2.0*ku3+ku4)/6.0;
+            evaluations += 4;
+            break;
+        }
+        default :
+            break;
+        }
+        if (v > _T_) break; // the neuron will fire at the next update, the end of the trajectory is useless
     }
+    return evaluations;
 }
 
-void Neurone::computeI()
+size_t Neurone::adaptiveStep(const Integration& integration)
 {
-    I = w*_RNG->normal(0.0,1.0) + 0.5*getSumExcitator() - getSumInhibitor();
+    double t(0.0), h(_DT_);
+    double kv1(dv(v,u)), ku1(du(v,u));
+    size_t evaluations(1);
+    while (_DT_-t > 1e-12 and v <= _T_) { // the margin avoids a last step of a rounding error size
+        h = std::min(h, _DT_-t);
+        double kv2(dv(v+0.5*h*kv1,u+0.5*h*ku1)), ku2(du(v+0.5*h*kv1,u+0.5*h*ku1));
+        double kv3(dv(v+0.75*h*kv2,u+0.75*h*ku2)), ku3(du(v+0.75*h*kv2,u+0.75*h*ku2));
+        double newV(v + h*(2.0*kv1+3.0*kv2+4.0*kv3)/9.0);
+        double newU(u + h*(2.0*ku1+3.0*ku2+4.0*ku3)/9.0);
+        double kv4(dv(newV,newU)), ku4(du(newV,newU)); // first evaluation of the next step if this one is accepted
+        evaluations += 3;
+
+        double error(std::abs(h*(-5.0*kv1+6.0*kv2+8.0*kv3-9.0*kv4)/72.0)); // difference with the embedded second order solution
+        double factor(error>0.0 ? 0.9*std::cbrt(integration.tolerance/error) : 2.0);
+        if (error<=integration.tolerance or h<=_INTEGRATION_MIN_STEP_) {
+            t += h;
+            v = newV;
+            u = newU;
+            kv1 = kv4;
+            ku1 = ku4;
+            h *= std::min(2.0, factor);
+        } else {
+            h *= std::max(0.2, factor);
+        }
+        h = std::max(h, _INTEGRATION_MIN_STEP_);
+    }
+    return evaluations;
+}
+
+double Neurone::dv(double v_, double u_) const
+{
+    return 0.04*v_*v_ + 5.0*v_ + 140.0 - u_ + I;
+}
+
+double Neurone::du(double v_, double u_) const
+{
+    return a*(b*v_-u_);
+}
+
+void Neurone::computeI(RandomNumbers& generator)
+{
+    computeI(generator, getSumExcitator(), getSumInhibitor());
+}
+
+void Neurone::computeI(RandomNumbers& generator, double sumExcitator, double sumInhibitor)
+{
+    I = w*generator.normal(0.0,1.0) + 0.5*sumExcitator - sumInhibitor;
 }
 
 double Neurone::getSumExcitator() const
@@ -104,7 +205,7 @@ double Neurone::getSumInhibitor() const
 double Neurone::getValence() const
 {
     double valence(0.0);
-    for(auto interaction : neighborhood) {
+    for(const auto& interaction : neighborhood) {
         if(interaction.neurone->getExcitator()) valence+=0.5*interaction.bondStrength; //excitator
         if(!interaction.neurone->getExcitator()) valence-=interaction.bondStrength; //inhibitor
     }
@@ -116,11 +217,10 @@ void Neurone::printSample(std::ofstream& outfile) const
     outfile << "\t" << v << "\t" << u << "\t" << I;
 }
 
-void Neurone::printParams(std::ofstream& outfile) const
+void Neurone::printParams(std::ostream& outfile) const
 {
     double valence(getValence());
-    outfile << type << "\t" << a << "\t" << b << "\t" << c << "\t" << d << "\t" << !excitator << "\t" << neighborhood.size() << "\t" << valence;
-    outfile << std::endl;
+    outfile << type << "\t" << a << "\t" << b << "\t" << c << "\t" << d << "\t" << !excitator << "\t" << neighborhood.size() << "\t" << valence << "\n";
 }
 
 bool Neurone::isFiring() const
@@ -143,17 +243,62 @@ void Neurone::setFiringState(bool state)
     firing = state;
 }
 
+void Neurone::setCurrent(double current)
+{
+    I = current;
+}
+
 bool Neurone::isType(std::string typeCheck) const
 {
     return (type==typeCheck);
 }
 
+const std::string& Neurone::getType() const
+{
+    return type;
+}
+
+NeuronValues Neurone::getParameters() const
+{
+    return {a, b, c, d, w, excitator};
+}
+
 bool Neurone::inNeighborhood(Neurone* neuron) const
 {
-    for(auto interaction : neighborhood) {
+    for(const auto& interaction : neighborhood) {
         if(interaction.neurone==neuron) return true;
     }
 
     return false;
 }
 
+
+double Neurone::getPotential() const
+{
+    return v;
+}
+
+double Neurone::getRelaxation() const
+{
+    return u;
+}
+
+double Neurone::getCurrent() const
+{
+    return I;
+}
+
+const NeuroneInteraction& Neurone::getLink(size_t i) const
+{
+    return neighborhood[i];
+}
+
+View<NeuroneInteraction> Neurone::getLinks() const
+{
+    return View<NeuroneInteraction>(neighborhood.data(), neighborhood.size());
+}
+
+void Neurone::setLinkStrength(size_t i, double strength)
+{
+    neighborhood[i].bondStrength = strength;
+}
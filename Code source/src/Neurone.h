@@ -1,4 +1,7 @@
+#pragma once
 #include "constants.h"
+#include "Arena.h"
+#include "View.h"
 
 
 /*! @class Neurone
@@ -12,6 +15,7 @@
 */
 
 class Neurone;
+class RandomNumbers;
 
 /// * structure to assemble the neurone pointer and the strength of its bond *
 struct NeuroneInteraction {
@@ -19,6 +23,9 @@ struct NeuroneInteraction {
     double bondStrength;
 };
 
+/// \typedef Links represents the list of the links of a neuron (in the \ref Arena of its \ref Network, or on the heap).
+typedef std::vector<NeuroneInteraction, ArenaAllocator<NeuroneInteraction> > Links;
+
 class Neurone
 {
 
@@ -28,29 +35,38 @@ public:
      A \ref Neurone can be constructed in two different ways. The first one constructs the neuron according to Izhikevich model and the second one implement a more rational model for all the cellular parameters (a, b, c and d). Each neuron is linked to other neurons and knows to which it is connected.
      \param chosen_type (string) :  the type of the neuron to construct
      \param delta (double) : noise parameter for the more rational model.
+     \param generator (RandomNumbers&) : random generator of the simulation (the neuron does not keep it).
      \param strength (double) : strength of the connection to create.
+     *allocateLinks()* allocates the memory of exactly \b number links (the existing links are kept), in the given \ref Arena if any, so that the following calls to *addLink()* do not allocate.
     */
 ///@{
-    Neurone (std::string chosen_type);
-    Neurone (std::string chosen_type, double delta);
+    Neurone (std::string chosen_type, RandomNumbers& generator);
+    Neurone (std::string chosen_type, double delta, RandomNumbers& generator);
     ~Neurone();
     void initialize(std::string type);
-    double deltaFactor(double delta);
+    double deltaFactor(double delta, RandomNumbers& generator);
     void addLink(Neurone* neurone, double strength);
+    void allocateLinks(size_t number, Arena* arena=nullptr);
 ///@}
 
-    /*! @brief Update the membrane potential and relaxation variable of a Neurone each "dt" interval of time (the time is counted in milliseconds). The value of its membrane potential determines the state of the neuron. The neuron is updated according to its activation state : if it is firing, it transmittes an impulse along its axone; if not, it receives the impulsions of the firing neurons it is connected to. Its membrane potential is updated twice a millisecond and it's relaxation variable is updated only once a milliseconde.
+    /*! @brief Update the membrane potential and relaxation variable of a Neurone each "dt" interval of time (the time is counted in milliseconds). The value of its membrane potential determines the state of the neuron. The neuron is updated according to its activation state : if it is firing, it transmittes an impulse along its axone; if not, it receives the impulsions of the firing neurons it is connected to. By default, its membrane potential is updated twice a millisecond and it's relaxation variable is updated only once a milliseconde.
+        \param integration (Integration) : numerical scheme used to integrate the neuron during the time step (see \ref IntegrationMethod). The schemes other than ORIGINAL stop integrating as soon as the threshold is crossed, the spike is then emitted at the next update.
+        \return the number of evaluations of the membrane potential equation.
     */
+///@{
     void update();
+    size_t update(const Integration& integration);
+///@}
 
     /*! @name Compute the synaptic current
-          This methods compute the current \b *this receives thanks to the strength of all the connections it does with others.
+          This methods compute the current \b *this receives thanks to the strength of all the connections it does with others. The sums of the strengths of the links from the firing neurons can also be given, when they are computed by the \ref Network (see \ref Network::useDenseLinks()).
          \n *getSumExcitator()* sums the strength of all the connections the neuron receives from firing excitator neurons (types *RS*, *IB*, *CH*).
          \n *getSumInhibitor()* sums  the strength of all the connections the neuron receives from firing inhibitor neurons (types *FS*, *LTS*).
          \n *getValence()* sums the the strength of all the connections the neuron receives. It adds half of the strength if the connected neuron is excitator and it substract the strength if the connected neuron is inhibitor. (This method is usefull for the parameter output file).
     */
 ///@{
-    void computeI();
+    void computeI(RandomNumbers& generator);
+    void computeI(RandomNumbers& generator, double sumExcitator, double sumInhibitor);
     double getSumExcitator()const;
     double getSumInhibitor()const;
     double getValence() const;
@@ -61,7 +77,7 @@ public:
         \param outfile (ostream&) : the name of the output file to write the results on.
     */
 ///@{
-    void printParams(std::ofstream& outfile) const;
+    void printParams(std::ostream& outfile) const;
     void printSample(std::ofstream& outfile) const;
 ///@}
 
@@ -73,13 +89,30 @@ public:
     size_t getSizeNeighborhood() const;
     bool getExcitator() const;
     void setFiringState(bool state);
+    void setCurrent(double current);
     bool isType(std::string typeCheck) const;
+    const std::string& getType() const;
+    /// parameters a, b, c, d, w and excitatory state of the neuron
+    NeuronValues getParameters() const;
     bool inNeighborhood(Neurone* neuron) const;
+    double getPotential() const;
+    double getRelaxation() const;
+    double getCurrent() const;
+    const NeuroneInteraction& getLink(size_t i) const;
+    /// all the links of the neuron, without copy
+    View<NeuroneInteraction> getLinks() const;
+    void setLinkStrength(size_t i, double strength);
 ///@}
 
 private:
+    /// right hand side of the model equations
+    double dv(double v_, double u_) const;
+    double du(double v_, double u_) const;
+    /// one step of each integration method
+    size_t adaptiveStep(const Integration& integration);
+
     ///list of all the interactions of *this with the other neurones
-    std::vector<NeuroneInteraction> neighborhood;
+    Links neighborhood;
     ///membrane potential
     double v;
     ///relaxation variable
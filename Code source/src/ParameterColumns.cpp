@@ -0,0 +1,84 @@
+#include "ParameterColumns.h"
+#include <algorithm>
+#include <cstring>
+
+ParameterColumns::ParameterColumns(const Network& network, const Communicator* communicator)
+{
+    for (const auto& type : NeuronParam) names.push_back(type.first);
+
+    const Neurons& neurons(network.getNeurons());
+    for (size_t i(0); i<neurons.size(); ++i) {
+        if (!network.owns(i)) continue;
+        NeuronValues values(neurons[i]->getParameters());
+        types.push_back(std::find(names.begin(), names.end(), neurons[i]->getType())-names.begin());
+        a.push_back(values.a);
+        b.push_back(values.b);
+        c.push_back(values.c);
+        d.push_back(values.d);
+        inhibitory.push_back(!values.exci);
+        degrees.push_back(network.getDegree(i));
+        valences.push_back(network.getValence(i));
+    }
+
+    if (communicator and communicator->getSize()>1) {
+        gather(types, communicator);
+        gather(a, communicator);
+        gather(b, communicator);
+        gather(c, communicator);
+        gather(d, communicator);
+        gather(inhibitory, communicator);
+        gather(degrees, communicator);
+        gather(valences, communicator);
+    }
+}
+
+template<class T>
+void ParameterColumns::gather(std::vector<T>& column, const Communicator* communicator)
+{
+    std::string all(communicator->gather(std::string(reinterpret_cast<const char*>(column.data()), column.size()*sizeof(T)))); // the neurons of each process follow the ones of the previous rank
+    column.resize(all.size()/sizeof(T));
+    if (!all.empty()) std::memcpy(column.data(), all.data(), all.size());
+}
+
+void ParameterColumns::print(std::ostream& outfile) const
+{
+    TextBuffer text;
+    for (size_t i(0); i<types.size(); ++i) {
+        text << names[types[i]] << '\t' << a[i] << '\t' << b[i] << '\t' << c[i] << '\t' << d[i] << '\t' << bool(inhibitory[i]) << '\t' << size_t(degrees[i]) << '\t' << valences[i] << '\n';
+        if (text.isFull()) text.write(outfile);
+    }
+    text.write(outfile);
+    if (!outfile.good()) throw(OUTPUT_ERROR(std::string("The parameters output file is not in good condition, it is impossible to write on it. \n")));
+}
+
+void ParameterColumns::write(std::ostream& outfile) const
+{
+    std::vector<uint64_t> header{types.size(), names.size()};
+    outfile.write(reinterpret_cast<const char*>(header.data()), header.size()*sizeof(uint64_t));
+    for (const auto& name : names) {
+        uint64_t length(name.size());
+        outfile.write(reinterpret_cast<const char*>(&length), sizeof(uint64_t));
+        outfile.write(name.data(), length);
+    }
+    outfile.write(reinterpret_cast<const char*>(types.data()), types.size()*sizeof(uint8_t));
+    for (const auto* column : {&a, &b, &c, &d}) outfile.write(reinterpret_cast<const char*>(column->data()), column->size()*sizeof(double));
+    outfile.write(reinterpret_cast<const char*>(inhibitory.data()), inhibitory.size()*sizeof(uint8_t));
+    outfile.write(reinterpret_cast<const char*>(degrees.data()), degrees.size()*sizeof(uint64_t));
+    outfile.write(reinterpret_cast<const char*>(valences.data()), valences.size()*sizeof(double));
+    if (!outfile.good()) throw(OUTPUT_ERROR(std::string("The parameters output file is not in good condition, it is impossible to write on it. \n")));
+}
+
+size_t ParameterColumns::getNumberNeurons() const
+{
+    return types.size();
+}
+
+const std::vector<uint64_t>& ParameterColumns::getDegrees() const
+{
+    return degrees;
+}
+
+const std::vector<double>& ParameterColumns::getValences() const
+{
+    return valences;
+}
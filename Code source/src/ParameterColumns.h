@@ -0,0 +1,61 @@
+#pragma once
+#include "Network.h"
+#include <cstdint>
+
+/*! @class ParameterColumns
+
+ The ParameterColumns class gathers the parameters of all the neurons of a \ref Network in columns (one array per parameter) : type, a, b, c, d, inhibitory, degree (number of links received) and valence (see \ref Neurone::getValence()).
+
+ The columns are filled in one pass over the neurons and their links when the ParameterColumns is built, then written at once, either as the text of the output file which name has the suffix _parameters.txt (one line per neuron, the same text as \ref Neurone::printParams()), or as a binary file of columns (suffix _parameters.bin), much smaller and faster to write and to read for big networks (see *write()*).
+
+ In the distributed mode, each process fills the columns of the neurons it owns, and the rank 0 gathers them (see \ref Communicator::gather()).
+*/
+
+class ParameterColumns
+{
+
+public:
+
+    /*! @brief Fill the columns.
+        \param network (Network&) : the network whose neurons are described.
+        \param communicator (Communicator*) : in the distributed mode, only the rank 0 gets the columns of the whole network, the other ranks get empty columns. By default (nullptr), all the neurons are owned.
+    */
+    ParameterColumns(const Network& network, const Communicator* communicator=nullptr);
+
+    /*! @name Display the columns in an output file.
+        *print()* writes one line of text per neuron (see \ref Network::headerParameters() for the header).
+        *write()* writes the columns in binary format (native endianness) :
+        \verbatim
+        uint64 N, uint64 T, T times (uint64 length, char name[length]),
+        uint8 type[N], double a[N], double b[N], double c[N], double d[N],
+        uint8 inhibitory[N], uint64 degree[N], double valence[N]
+        \endverbatim
+        The type of neuron \b i is the name number type[i] among the T names of types.
+        \param outfile (ostream&) : the output file.
+    */
+///@{
+    void print(std::ostream& outfile) const;
+    void write(std::ostream& outfile) const;
+///@}
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    size_t getNumberNeurons() const;
+    const std::vector<uint64_t>& getDegrees() const;
+    const std::vector<double>& getValences() const;
+///@}
+
+private:
+    /// replace a column by the concatenation of the columns of every process (on the rank 0)
+    template<class T>
+    void gather(std::vector<T>& column, const Communicator* communicator);
+
+    std::vector<std::string> names;
+    std::vector<uint8_t> types;
+    std::vector<double> a, b, c, d;
+    std::vector<uint8_t> inhibitory;
+    std::vector<uint64_t> degrees;
+    std::vector<double> valences;
+};
@@ -0,0 +1,100 @@
+#include "Plasticity.h"
+#include <unordered_map>
+#include <cstdint>
+
+Plasticity::Plasticity(const std::vector<Neurone*>& neurons_, double maxStrength_, double aPlus_, double aMinus_, double tauPlus_, double tauMinus_) : neurons(neurons_), preTrace(neurons_.size(), 0.0), postTrace(neurons_.size(), 0.0), lastSpike(neurons_.size(), 0), maxStrength(maxStrength_), aPlus(aPlus_), aMinus(aMinus_), tauPlus(tauPlus_), tauMinus(tauMinus_)
+{
+    if (tauPlus<=0.0 or tauMinus<=0.0) throw std::invalid_argument("The time constants of the plasticity traces must be positive.");
+
+    std::unordered_map<const Neurone*, size_t> indices; // only used while indexing the links
+    for (size_t i(0); i<neurons.size(); ++i) indices[neurons[i]] = i;
+
+    inOffsets.assign(neurons.size()+1, 0);
+    outOffsets.assign(neurons.size()+1, 0);
+    for (size_t i(0); i<neurons.size(); ++i) {
+        inOffsets[i+1] = inOffsets[i] + neurons[i]->getSizeNeighborhood();
+        for (size_t k(0); k<neurons[i]->getSizeNeighborhood(); ++k) {
+            ++outOffsets[indices.at(neurons[i]->getLink(k).neurone)+1];
+        }
+    }
+    for (size_t i(0); i<neurons.size(); ++i) outOffsets[i+1] += outOffsets[i];
+
+    inPre.resize(inOffsets.back());
+    out.resize(outOffsets.back());
+    std::vector<size_t> filled(outOffsets.begin(), outOffsets.end()-1); // next free position in the outgoing list of each neuron
+    for (size_t i(0); i<neurons.size(); ++i) {
+        for (size_t k(0); k<neurons[i]->getSizeNeighborhood(); ++k) {
+            size_t pre(indices.at(neurons[i]->getLink(k).neurone));
+            inPre[inOffsets[i]+k] = pre;
+            out[filled[pre]++] = {i, k};
+        }
+    }
+}
+
+double Plasticity::decay(double value, size_t last, size_t time, double tau)
+{
+    return value*std::exp(-double(time-last)/tau);
+}
+
+void Plasticity::onSpikes(const std::vector<size_t>& fired, size_t time)
+{
+    // potentiation : the firing neuron is postsynaptic, its incoming excitatory links are strengthened
+    for (auto post : fired) {
+        Neurone* neuron(neurons[post]);
+        for (size_t k(0); k<neuron->getSizeNeighborhood(); ++k) {
+            size_t pre(inPre[inOffsets[post]+k]);
+            if (!neurons[pre]->getExcitator()) continue;
+            double strength(neuron->getLink(k).bondStrength + aPlus*maxStrength*getPreTrace(pre, time));
+            neuron->setLinkStrength(k, std::min(strength, maxStrength));
+        }
+    }
+
+    // depression : the firing neuron is presynaptic, its outgoing links are weakened
+    for (auto pre : fired) {
+        if (!neurons[pre]->getExcitator()) continue;
+        for (size_t j(outOffsets[pre]); j<outOffsets[pre+1]; ++j) {
+            Neurone* neuron(neurons[out[j].post]);
+            double strength(neuron->getLink(out[j].link).bondStrength - aMinus*maxStrength*getPostTrace(out[j].post, time));
+            neuron->setLinkStrength(out[j].link, std::max(strength, 0.0));
+        }
+    }
+
+    // the traces are increased once all the links are updated, so that simultaneous spikes do not modify the links
+    for (auto i : fired) {
+        preTrace[i] = getPreTrace(i, time) + 1.0;
+        postTrace[i] = getPostTrace(i, time) + 1.0;
+        lastSpike[i] = time;
+    }
+}
+
+void Plasticity::dumpWeights(std::ostream& outfile, size_t time) const
+{
+    std::vector<uint64_t> header{time, neurons.size(), inPre.size()};
+    std::vector<uint64_t> offsets(inOffsets.begin(), inOffsets.end());
+    std::vector<uint64_t> pre(inPre.begin(), inPre.end());
+    std::vector<double> strength(inPre.size());
+    for (size_t i(0); i<neurons.size(); ++i) {
+        for (size_t k(0); k<neurons[i]->getSizeNeighborhood(); ++k) strength[inOffsets[i]+k] = neurons[i]->getLink(k).bondStrength;
+    }
+
+    outfile.write(reinterpret_cast<const char*>(header.data()), header.size()*sizeof(uint64_t));
+    outfile.write(reinterpret_cast<const char*>(offsets.data()), offsets.size()*sizeof(uint64_t));
+    outfile.write(reinterpret_cast<const char*>(pre.data()), pre.size()*sizeof(uint64_t));
+    outfile.write(reinterpret_cast<const char*>(strength.data()), strength.size()*sizeof(double));
+    if (!outfile.good()) throw(OUTPUT_ERROR(std::string("The weights output file is not in good condition, it is impossible to write on it. \n")));
+}
+
+double Plasticity::getPreTrace(size_t neuron, size_t time) const
+{
+    return decay(preTrace[neuron], lastSpike[neuron], time, tauPlus);
+}
+
+double Plasticity::getPostTrace(size_t neuron, size_t time) const
+{
+    return decay(postTrace[neuron], lastSpike[neuron], time, tauMinus);
+}
+
+size_t Plasticity::getNumberLinks() const
+{
+    return inPre.size();
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Neurone.h"
+
+/*! @class Plasticity
+
+ The Plasticity class implements spike-timing-dependent plasticity (STDP) on the links of a \ref Network.
+ Each neuron carries two exponential traces : a presynaptic trace \b x (time constant tauPlus) and a postsynaptic trace \b y (time constant tauMinus). Both are increased by 1 each time the neuron fires and decay exponentially between two spikes. The decay is computed lazily (only when the trace is read or increased), so no work is done for neurons that do not fire.
+
+ At each time step, only the firing neurons are visited :
+ - when a neuron fires as a postsynaptic neuron, each of its incoming excitatory links is potentiated by aPlus * maxStrength * x(pre),
+ - when a neuron fires as a presynaptic neuron, each of its outgoing links is depressed by aMinus * maxStrength * y(post).
+
+ The cost of a step is thus proportional to the number of spikes times the number of links of the firing neurons, not to the total number of links. Only links coming from excitatory neurons are plastic and strengths always stay in [0, maxStrength].
+
+ The links can be written in a binary file (see \ref dumpWeights()).
+*/
+
+class Plasticity
+{
+
+public:
+
+    /*! @name Plasticity construction
+        Index the incoming and outgoing links of each neuron of the set once for all (links do not change during the simulation, only their strength).
+        \param neurons_ (vector<Neurone*>) : the neurons of the network, in the network order.
+        \param maxStrength_ (double) : upper bound of the strength of a link.
+        \param aPlus_, aMinus_ (double) : potentiation and depression amplitudes (relative to maxStrength).
+        \param tauPlus_, tauMinus_ (double) : time constants of the presynaptic and postsynaptic traces (in time steps).
+    */
+///@{
+    Plasticity(const std::vector<Neurone*>& neurons_, double maxStrength_, double aPlus_=_STDP_A_PLUS_, double aMinus_=_STDP_A_MINUS_, double tauPlus_=_STDP_TAU_PLUS_, double tauMinus_=_STDP_TAU_MINUS_);
+///@}
+
+    /*! @brief Apply the STDP rule for the neurons which fired at the given time, then increase their traces.
+        \param fired (vector<size_t>) : indices (in the network) of the neurons that fired during this time step.
+        \param time (size_t) : current time step.
+    */
+    void onSpikes(const std::vector<size_t>& fired, size_t time);
+
+    /*! @brief Writes a snapshot of all the link strengths in binary format (native endianness), which can be appended several times in the same file :
+        \verbatim
+        uint64 time, uint64 N, uint64 nnz,
+        uint64 offsets[N+1], uint64 presynaptic[nnz], double strength[nnz]
+        \endverbatim
+        The links received by neuron \b i are stored between offsets[i] and offsets[i+1] (compressed sparse rows, one row per postsynaptic neuron).
+        \param outfile (ostream&) : binary stream on which to write the snapshot.
+        \param time (size_t) : the moment of the simulation to consider.
+    */
+    void dumpWeights(std::ostream& outfile, size_t time) const;
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    double getPreTrace(size_t neuron, size_t time) const;
+    double getPostTrace(size_t neuron, size_t time) const;
+    size_t getNumberLinks() const;
+///@}
+
+private:
+    /// value of a trace at a given time, knowing its value at its last update
+    static double decay(double value, size_t last, size_t time, double tau);
+
+    /// position of a link : the postsynaptic neuron and the index of the link in its neighborhood
+    struct LinkPosition {
+        size_t post;
+        size_t link;
+    };
+
+    std::vector<Neurone*> neurons;
+    ///incoming links : the presynaptic index of link k of neuron i is inPre[inOffsets[i]+k]
+    std::vector<size_t> inOffsets, inPre;
+    ///outgoing links : the links sent by neuron i are out[outOffsets[i]] to out[outOffsets[i+1]-1]
+    std::vector<size_t> outOffsets;
+    std::vector<LinkPosition> out;
+    ///traces and time of their last update
+    std::vector<double> preTrace, postTrace;
+    std::vector<size_t> lastSpike;
+    double maxStrength, aPlus, aMinus, tauPlus, tauMinus;
+};
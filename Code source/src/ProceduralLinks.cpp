@@ -0,0 +1,108 @@
+#include "ProceduralLinks.h"
+#include <limits>
+#include <algorithm>
+
+ProceduralLinks::ProceduralLinks(size_t numberNeurons_, size_t first_, unsigned long int seed, unsigned long int stream, double maxStrength_) : numberNeurons(numberNeurons_), first(first_), base(mix(seed ^ mix(stream))), maxStrength(maxStrength_), total(0)
+{
+    unsigned int bits(2); // at least one bit on each side
+    size_t others(numberNeurons>1 ? numberNeurons-1 : 1);
+    while (bits<64 and (uint64_t(1) << bits) < others) ++bits;
+    leftBits = bits/2;
+    rightBits = bits-leftBits;
+}
+
+uint64_t ProceduralLinks::mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+void ProceduralLinks::addNeuron(size_t degree)
+{
+    if (degree>=numberNeurons or degree>std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("The number of connections received by a neuron can not exceed the total number of neurons in the network.");
+    degrees.push_back(degree);
+    total += degree;
+}
+
+uint64_t ProceduralLinks::key(size_t index) const
+{
+    return mix(base ^ mix(index));
+}
+
+void ProceduralLinks::roundKeys(uint64_t neuronKey, uint64_t keys[_FEISTEL_ROUNDS_]) const
+{
+    for (unsigned int round(0); round<_FEISTEL_ROUNDS_; ++round) keys[round] = mix(neuronKey + round);
+}
+
+size_t ProceduralLinks::permute(const uint64_t keys[_FEISTEL_ROUNDS_], size_t k) const
+{
+    uint64_t others(numberNeurons-1);
+    uint64_t x(k);
+    do { // cycle walking : the permutation of the integers of leftBits+rightBits bits is applied again until the result is one of the other neurons
+        unsigned int leftSize(leftBits), rightSize(rightBits);
+        uint64_t left(x >> rightSize), right(x & ((uint64_t(1) << rightSize)-1));
+        for (unsigned int round(0); round<_FEISTEL_ROUNDS_; ++round) { // the left part is replaced by the right one, the right part by the left one mixed with a hash of the right one
+            uint64_t next(left ^ ((((right + keys[round]) * 0xd6e8feb86659fd93ULL) >> 32) & ((uint64_t(1) << leftSize)-1))); // the high bits of the product depend on all the bits of right
+            left = right;
+            right = next;
+            std::swap(leftSize, rightSize);
+        }
+        x = (left << rightSize) | right;
+    } while (x>=others);
+    return x;
+}
+
+double ProceduralLinks::strength(uint64_t neuronKey, size_t k) const
+{
+    return (mix(~neuronKey + k) >> 11) * (1.0/9007199254740992.0) * maxStrength; // 53 random bits, uniform in [0, maxStrength)
+}
+
+void ProceduralLinks::sums(size_t neuron, const std::vector<uint8_t>& states, double& excitation, double& inhibition) const
+{
+    double totals[3] = {0.0, 0.0, 0.0};
+    size_t self(first+neuron);
+    uint64_t neuronKey(key(self)), keys[_FEISTEL_ROUNDS_];
+    roundKeys(neuronKey, keys);
+    for (size_t k(0); k<degrees[neuron]; ++k) {
+        size_t other(permute(keys, k));
+        uint8_t state(states[other<self ? other : other+1]); // the indices skip the neuron itself
+        if (state) totals[state] += strength(neuronKey, k); // the strength is only computed for the firing neurons
+    }
+    excitation = totals[1];
+    inhibition = totals[2];
+}
+
+size_t ProceduralLinks::getNumberNeurons() const
+{
+    return degrees.size();
+}
+
+size_t ProceduralLinks::getNumberLinks() const
+{
+    return total;
+}
+
+size_t ProceduralLinks::getNumberLinks(size_t neuron) const
+{
+    return degrees[neuron];
+}
+
+size_t ProceduralLinks::getSource(size_t neuron, size_t k) const
+{
+    uint64_t keys[_FEISTEL_ROUNDS_];
+    roundKeys(key(first+neuron), keys);
+    size_t other(permute(keys, k));
+    return other<first+neuron ? other : other+1;
+}
+
+double ProceduralLinks::getStrength(size_t neuron, size_t k) const
+{
+    return strength(key(first+neuron), k);
+}
+
+size_t ProceduralLinks::getMemory() const
+{
+    return degrees.capacity()*sizeof(uint32_t);
+}
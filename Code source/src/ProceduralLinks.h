@@ -0,0 +1,70 @@
+#pragma once
+#include "constants.h"
+#include <cstdint>
+
+/*! @class ProceduralLinks
+
+ The ProceduralLinks class gives the links received by the neurons of a \ref Network without storing them : only the number of links of each neuron is kept, and its links are computed again each time they are needed, from the seed of the network, the index of the neuron and the index of the link.
+
+ The presynaptic neurons of a neuron are the images of 0, 1, 2... by a permutation of the other neurons of the network, chosen by the key of the neuron (a Feistel network of \ref _FEISTEL_ROUNDS_ rounds on the bits of the number of other neurons, whose round function is a multiplication by an odd constant of one part of the bits plus the key of the round, with cycle walking to stay among the neurons : less than two permutations per link on average), so they are distinct and never the neuron itself, like the links drawn by the \ref Network. The strength of the link \b k is uniform between 0 and the maximal strength, from a hash of the key of the neuron and of \b k.
+ The keys and the strengths come from the finalizer of splitmix64 : the links of a neuron do not depend on the order in which the neurons are visited, nor on the process which owns the neuron.
+
+ The memory of the links is thus 4 bytes per neuron whatever their number, and *sums()* computes the links of a neuron to add the strengths of the ones from firing neurons : the synaptic currents cost more computation than with stored links, but networks with more links than the memory can hold can be simulated.
+*/
+
+class ProceduralLinks
+{
+
+public:
+
+    /*! @brief \param numberNeurons (size_t) : number of neurons of the network.
+        \param first_ (size_t) : index in the network of the first neuron whose links are given (the first neuron owned by the process).
+        \param seed, stream (unsigned long int) : seed and stream of the random generator of the network (see \ref RandomNumbers), from which the keys of the neurons are derived.
+        \param maxStrength_ (double) : maximal strength of a link.
+    */
+    ProceduralLinks(size_t numberNeurons, size_t first_, unsigned long int seed, unsigned long int stream, double maxStrength_);
+
+    /*! @brief Add a neuron, in the order of the neurons (the first one added is the neuron \b first of the network).
+        \param degree (size_t) : number of links received by the neuron (at most the number of neurons - 1).
+    */
+    void addNeuron(size_t degree);
+
+    /*! @brief Sums of the strengths of the links from the firing excitatory and inhibitory neurons to a neuron, with the same states as \ref QuantizedLinks::sums().
+        \param neuron (size_t) : index of the neuron among the neurons added.
+        \param states (vector<uint8_t>) : state of each neuron of the network : 0 if it is not firing, 1 if it is a firing excitatory neuron, 2 if it is a firing inhibitory neuron.
+        \param excitation, inhibition (double&) : the sums.
+    */
+    void sums(size_t neuron, const std::vector<uint8_t>& states, double& excitation, double& inhibition) const;
+
+    /*!
+       @name Utility methods (getters)
+       *getSource()* and *getStrength()* give the link \b k of a neuron (among the neurons added), *getMemory()* the memory of the degrees in bytes.
+    */
+///@{
+    size_t getNumberNeurons() const;
+    size_t getNumberLinks() const;
+    size_t getNumberLinks(size_t neuron) const;
+    size_t getSource(size_t neuron, size_t k) const;
+    double getStrength(size_t neuron, size_t k) const;
+    size_t getMemory() const;
+///@}
+
+private:
+    /// finalizer of splitmix64 : a bijection of the 64 bits integers, whose bits all depend on all the bits of x
+    static uint64_t mix(uint64_t x);
+    /// key of a neuron of the network
+    uint64_t key(size_t index) const;
+    /// keys of the rounds of the permutation of a neuron
+    void roundKeys(uint64_t neuronKey, uint64_t keys[_FEISTEL_ROUNDS_]) const;
+    /// index among the other neurons (from 0 to the number of neurons - 2) of the presynaptic neuron of the link k
+    size_t permute(const uint64_t keys[_FEISTEL_ROUNDS_], size_t k) const;
+    double strength(uint64_t neuronKey, size_t k) const;
+
+    size_t numberNeurons, first;
+    uint64_t base;
+    double maxStrength;
+    ///the permutations are made on the integers of leftBits+rightBits bits, the number of bits of the number of neurons - 2
+    unsigned int leftBits, rightBits;
+    std::vector<uint32_t> degrees;
+    size_t total;
+};
@@ -0,0 +1,93 @@
+#include "QuantizedLinks.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QuantizedLinks::QuantizedLinks(WeightPrecision precision_, Arena* arena) : precision(precision_), offsets(ArenaAllocator<uint64_t>(arena)), sources(ArenaAllocator<uint32_t>(arena)), shortWeights(ArenaAllocator<uint16_t>(arena)), byteWeights(ArenaAllocator<uint8_t>(arena)), scales(ArenaAllocator<double>(arena))
+{
+    if (precision!=SHORT_WEIGHTS and precision!=BYTE_WEIGHTS) throw std::invalid_argument("The strengths of the quantized links are written on 16 or 8 bits.");
+    offsets.push_back(0);
+}
+
+void QuantizedLinks::reserve(size_t neurons, size_t links)
+{
+    offsets.reserve(neurons+1);
+    scales.reserve(neurons);
+    sources.reserve(links);
+    if (precision==SHORT_WEIGHTS) shortWeights.reserve(links);
+    else byteWeights.reserve(links);
+}
+
+void QuantizedLinks::addNeuron(const std::vector<size_t>& sources_, const std::vector<double>& strengths)
+{
+    if (sources_.size()!=strengths.size()) throw std::invalid_argument("The number of links and number of strength are not the same so it is not possible to match a link with a strength. It is not possible to creat the links.");
+    double largest(strengths.empty() ? 0.0 : *std::max_element(strengths.begin(), strengths.end()));
+    double levels(precision==SHORT_WEIGHTS ? 65535.0 : 255.0);
+    double scale(largest/levels);
+    for (size_t k(0); k<strengths.size(); ++k) {
+        if (sources_[k]>std::numeric_limits<uint32_t>::max()) throw std::invalid_argument("The quantized links can only link the 2^32 first neurons of a network.");
+        if (strengths[k]<0.0) throw std::invalid_argument("The strength of a quantized link can not be negative.");
+        sources.push_back(sources_[k]);
+        double level(scale>0.0 ? std::round(strengths[k]/scale) : 0.0);
+        if (precision==SHORT_WEIGHTS) shortWeights.push_back(level);
+        else byteWeights.push_back(level);
+    }
+    offsets.push_back(sources.size());
+    scales.push_back(scale);
+}
+
+template<class W>
+void QuantizedLinks::sums(const Array<W>& weights, size_t neuron, const std::vector<uint8_t>& states, uint64_t totals[3]) const
+{
+    for (size_t k(offsets[neuron]); k<offsets[neuron+1]; ++k) totals[states[sources[k]]] += weights[k]; // the links from the neurons which do not fire go to totals[0]
+}
+
+void QuantizedLinks::sums(size_t neuron, const std::vector<uint8_t>& states, double& excitation, double& inhibition) const
+{
+    uint64_t totals[3] = {0, 0, 0};
+    if (precision==SHORT_WEIGHTS) sums(shortWeights, neuron, states, totals);
+    else sums(byteWeights, neuron, states, totals);
+    excitation = totals[1]*scales[neuron];
+    inhibition = totals[2]*scales[neuron];
+}
+
+size_t QuantizedLinks::getNumberNeurons() const
+{
+    return scales.size();
+}
+
+size_t QuantizedLinks::getNumberLinks() const
+{
+    return sources.size();
+}
+
+size_t QuantizedLinks::getNumberLinks(size_t neuron) const
+{
+    return offsets[neuron+1]-offsets[neuron];
+}
+
+size_t QuantizedLinks::getSource(size_t neuron, size_t k) const
+{
+    return sources[offsets[neuron]+k];
+}
+
+double QuantizedLinks::getStrength(size_t neuron, size_t k) const
+{
+    size_t link(offsets[neuron]+k);
+    return (precision==SHORT_WEIGHTS ? shortWeights[link] : byteWeights[link])*scales[neuron];
+}
+
+double QuantizedLinks::getScale(size_t neuron) const
+{
+    return scales[neuron];
+}
+
+WeightPrecision QuantizedLinks::getPrecision() const
+{
+    return precision;
+}
+
+size_t QuantizedLinks::getMemory() const
+{
+    return offsets.capacity()*sizeof(uint64_t) + sources.capacity()*sizeof(uint32_t) + shortWeights.capacity()*sizeof(uint16_t) + byteWeights.capacity()*sizeof(uint8_t) + scales.capacity()*sizeof(double);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "constants.h"
+#include "Arena.h"
+#include <cstdint>
+
+/*! @class QuantizedLinks
+
+ The QuantizedLinks class stores the links received by the neurons of a \ref Network in a compact form, instead of the list of links of each \ref Neurone (a pointer and a double, 16 bytes per link) : the links of all the neurons follow each other in one array, each link being the index of its presynaptic neuron (32 bits) and its strength rounded to an integer of 16 or 8 bits (see \ref WeightPrecision), so a link takes 6 or 5 bytes.
+
+ The strength of a link is its integer times the scale of the neuron which receives it : the largest strength of the links of the neuron divided by the largest integer (65535 or 255), so the rounding error of a strength is at most half the scale.
+ The integers of the links from the firing neurons are summed exactly, and the sums are multiplied by the scale once per neuron (see *sums()*).
+
+ The arrays are allocated in the \ref Arena of the \ref Network, with the neurons, so they are in huge pages and on the NUMA node of the process like the links of the neurons. Since the Arena does not free memory, *reserve()* must be called with the final size of the arrays before the links are added.
+*/
+
+class QuantizedLinks
+{
+
+public:
+
+    /*! @brief \param precision (WeightPrecision) : number of bits of the strengths (16 or 8).
+        \param arena (Arena*) : memory of the arrays (on the heap without Arena).
+    */
+    QuantizedLinks(WeightPrecision precision=SHORT_WEIGHTS, Arena* arena=nullptr);
+
+    /*! @name Fill the links
+        The links of the neurons are added in the order of the neurons.
+        *reserve()* allocates the memory of the neurons and of their links at once, when their number is known.
+        \param neurons (size_t) : number of neurons.
+        \param links (size_t) : total number of links.
+        \param sources (vector<size_t>) : index in the network of the presynaptic neuron of each link of the neuron.
+        \param strengths (vector<double>) : strength of each link of the neuron, not negative.
+    */
+///@{
+    void reserve(size_t neurons, size_t links);
+    void addNeuron(const std::vector<size_t>& sources, const std::vector<double>& strengths);
+///@}
+
+    /*! @brief Sums of the strengths of the links from the firing excitatory and inhibitory neurons to a neuron.
+        \param neuron (size_t) : index of the neuron among the neurons of the links.
+        \param states (vector<uint8_t>) : state of each neuron of the network : 0 if it is not firing, 1 if it is a firing excitatory neuron, 2 if it is a firing inhibitory neuron.
+        \param excitation, inhibition (double&) : the sums.
+    */
+    void sums(size_t neuron, const std::vector<uint8_t>& states, double& excitation, double& inhibition) const;
+
+    /*!
+       @name Utility methods (getters)
+       *getStrength()* gives the strength of the link \b k of a neuron after its rounding, *getMemory()* the memory of the links in bytes.
+    */
+///@{
+    size_t getNumberNeurons() const;
+    size_t getNumberLinks() const;
+    size_t getNumberLinks(size_t neuron) const;
+    size_t getSource(size_t neuron, size_t k) const;
+    double getStrength(size_t neuron, size_t k) const;
+    double getScale(size_t neuron) const;
+    WeightPrecision getPrecision() const;
+    size_t getMemory() const;
+///@}
+
+private:
+    /// sums of the integers of the links of a neuron from the firing neurons (index 1 : excitatory, 2 : inhibitory)
+    template<class T>
+    using Array = std::vector<T, ArenaAllocator<T> >;
+
+    template<class W>
+    void sums(const Array<W>& weights, size_t neuron, const std::vector<uint8_t>& states, uint64_t totals[3]) const;
+
+    WeightPrecision precision;
+    ///the links of the neuron i are the ones from offsets[i] to offsets[i+1]-1
+    Array<uint64_t> offsets;
+    Array<uint32_t> sources;
+    ///only the array of the chosen precision is used
+    Array<uint16_t> shortWeights;
+    Array<uint8_t> byteWeights;
+    Array<double> scales;
+};
@@ -1,12 +1,17 @@
 #include "Random.h"
 
-RandomNumbers::RandomNumbers(unsigned long int s) : seed(s)
+RandomNumbers::RandomNumbers(unsigned long int s, unsigned long int stream_) : seed(s), stream(stream_)
 {
     if (seed == 0) {
         std::random_device rd;
         seed = rd();
     }
-    rng = std::mt19937(seed);
+    if (stream == 0) {
+        rng = std::mt19937(seed);
+    } else {
+        std::seed_seq sequence{seed & 0xffffffffUL, (seed >> 16) >> 16, stream & 0xffffffffUL, (stream >> 16) >> 16};
+        rng = std::mt19937(sequence);
+    }
 }
 
 double RandomNumbers::uniform_double(double lower, double upper)
@@ -21,6 +26,12 @@ void RandomNumbers::uniform_double(std::vector<double> &res, double lower, doubl
     for (auto I=res.begin(); I!=res.end(); I++) *I = unif(rng) ;
 }
 
+size_t RandomNumbers::uniform_int(size_t lower, size_t upper)
+{
+    std::uniform_int_distribution<size_t> unif(lower, upper) ;
+    return unif(rng) ;
+}
+
 double RandomNumbers::normal(double mean, double sd)
 {
     std::normal_distribution<> norm(mean,sd) ;
@@ -43,3 +54,13 @@ void RandomNumbers::shuffle(std::vector<size_t> &res)
 {
     std::shuffle(res.begin(), res.end(), rng);
 }
+
+unsigned long int RandomNumbers::getSeed() const
+{
+    return seed;
+}
+
+unsigned long int RandomNumbers::getStream() const
+{
+    return stream;
+}
@@ -7,6 +7,9 @@
 
 /*! @class RandomNumbers
  * Random class based on standard c++-11 generators
+ *
+ * There is no generator shared by the whole program : each \ref Network owns its generators (see \ref Network::Network()), so several simulations can run in the same program, one after the other or in parallel threads, and each one gives the same results as if it was alone.
+ * The independent random sequences (streams) of a seed are derived as follows : the stream 0 is the Mersenne twister seeded with the seed itself (the sequence of the previous versions of the program), the stream k>0 is the Mersenne twister seeded with the std::seed_seq of the 32 bits words (seed low, seed high, k low, k high).
  */
 class RandomNumbers
 {
@@ -16,15 +19,17 @@ public:
     /*!@name Initialization
       The constructor initialiazes the generator \ref rng with the Mersenne twister *mt19937* engine from the standard library and seeds it.
       \param s (unsigned long int) : seed. If 0 (default) the seed is generated from a *random_device*.
+      \param stream (unsigned long int) : index of the random sequence derived from the seed (see above).
       */
-    RandomNumbers(unsigned long int s=0);
+    RandomNumbers(unsigned long int s=0, unsigned long int stream_=0);
 
     /*!@name Distributions
       These functions either fill the vector(first argument) with random numbers distributed according to the specific distribution or they return a single random number distributed according the specified distribution.
-      The additional arguments are the standard parameters of these distributions.
+      The additional arguments are the standard parameters of these distributions (the bounds of *uniform_int()* are included).
       */
 ///@{
     double uniform_double(double lower=0, double upper=1);
+    size_t uniform_int(size_t lower, size_t upper);
     void uniform_double(std::vector<double> &T, double lower=0, double upper=1);
     double normal(double mean=0, double sd=1);
     int poisson(double mean=1);
@@ -38,11 +43,17 @@ public:
     */
     void shuffle(std::vector<size_t> &res) ;
 
+    /*!@name Utility methods (getters)
+       *getSeed()* gives the seed (the one generated if 0 was given), *getStream()* the index of the random sequence.
+    */
+///@{
+    unsigned long int getSeed() const;
+    unsigned long int getStream() const;
+///@}
+
 private:
     std::mt19937 rng;
-    long int seed;
+    unsigned long int seed, stream;
 };
 
-extern RandomNumbers *_RNG;
-
 #endif //RANDOM_H
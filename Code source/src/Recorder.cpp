@@ -0,0 +1,123 @@
+#include "Recorder.h"
+
+Recorder::Recorder(const Network& network, const std::string& probesList, const std::string& variablesList, size_t stride_, size_t rows, const Communicator* communicator_) : stride(stride_), capacity(std::max<size_t>(rows, 1)), used(0), communicator(communicator_)
+{
+    if (stride==0) throw std::invalid_argument("The stride of the probes must be at least one time step.");
+
+    std::stringstream list(variablesList);
+    for (std::string name; std::getline(list, name, ','); ) {
+        if (name=="v") variables.push_back(POTENTIAL);
+        else if (name=="u") variables.push_back(RELAXATION);
+        else if (name=="I") variables.push_back(CURRENT);
+        else if (name=="firing") variables.push_back(FIRING);
+        else throw std::invalid_argument("The variable " + name + " can not be recorded (possible variables : v, u, I, firing).");
+    }
+
+    probes = network.selectNeurons(probesList);
+    const Neurons& all(network.getNeurons());
+    for (auto i : probes) {
+        neurons.push_back(all[i]);
+        owned.push_back(network.owns(i));
+    }
+    times.resize(capacity);
+    records.resize(capacity*probes.size()*variables.size());
+}
+
+void Recorder::record(size_t time)
+{
+    if (time%stride!=0) return;
+    if (isFull()) throw std::invalid_argument("The buffer of the probes is full, it must be written before recording.");
+
+    times[used] = time;
+    double* values(&records[used*neurons.size()*variables.size()]);
+    for (size_t p(0); p<neurons.size(); ++p) {
+        for (auto variable : variables) {
+            double value(0.0); // the values of the neurons owned by another process are added in flush()
+            if (owned[p]) {
+                switch (variable) {
+                case POTENTIAL :
+                    value = neurons[p]->getPotential();
+                    break;
+                case RELAXATION :
+                    value = neurons[p]->getRelaxation();
+                    break;
+                case CURRENT :
+                    value = neurons[p]->getCurrent();
+                    break;
+                case FIRING :
+                    value = neurons[p]->isFiring();
+                    break;
+                }
+            }
+            *values++ = value;
+        }
+    }
+    ++used;
+}
+
+void Recorder::header(std::ostream& outfile) const
+{
+    const std::vector<std::string> names{"v", "u", "I", "firing"};
+    outfile << "time";
+    for (auto probe : probes) {
+        for (auto variable : variables) outfile << "\t" << probe << "." << names[variable];
+    }
+    outfile << "\n";
+}
+
+void Recorder::flush(std::ostream& outfile)
+{
+    if (communicator) {
+        communicator->sum(records); // each value is only non zero on the process which owns the neuron
+        if (!communicator->isRoot()) {
+            used = 0;
+            return;
+        }
+    }
+
+    size_t columns(neurons.size()*variables.size());
+    for (size_t r(0); r<used; ++r) {
+        outfile << times[r];
+        for (size_t c(0); c<columns; ++c) outfile << "\t" << records[r*columns+c];
+        outfile << "\n";
+    }
+    outfile.flush();
+    used = 0;
+}
+
+void Recorder::clear()
+{
+    used = 0;
+}
+
+void Recorder::grow()
+{
+    capacity *= 2;
+    times.resize(capacity);
+    records.resize(capacity*neurons.size()*variables.size());
+}
+
+bool Recorder::isFull() const
+{
+    return used==capacity;
+}
+
+size_t Recorder::getNumberRecords() const
+{
+    return used;
+}
+
+const std::vector<double>& Recorder::getRecords() const
+{
+    return records;
+}
+
+const std::vector<size_t>& Recorder::getProbes() const
+{
+    return probes;
+}
+
+const std::vector<Recorder::Variable>& Recorder::getVariables() const
+{
+    return variables;
+}
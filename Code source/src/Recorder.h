@@ -0,0 +1,77 @@
+#pragma once
+#include "Network.h"
+
+/*! @class Recorder
+
+ The Recorder class records the time dependent variables of a set of neurons (the probes) chosen by the user, every \b stride time steps.
+
+ The probes are given as a list of neurons, see \ref Network::selectNeurons().
+
+ The variables are given as a list separated by commas among \b v (membrane potential), \b u (relaxation variable), \b I (current) and \b firing (1 if the neuron fires, 0 otherwise).
+
+ The probes are resolved to neurons once for all when the Recorder is built. The values are stored in a buffer allocated once, which is written in the output file (suffix _probes) only when it is full, so recording hundreds of probes does not slow down the simulation.
+*/
+
+class Recorder
+{
+
+public:
+
+    /// variables which can be recorded
+    enum Variable {POTENTIAL, RELAXATION, CURRENT, FIRING};
+
+    /*! @brief Resolve the probes and allocate the buffer.
+        \param network (Network&) : the network whose neurons are recorded.
+        \param probes (string) : the neurons to record (see \ref Network::selectNeurons()).
+        \param variables (string) : the variables to record (see above).
+        \param stride_ (size_t) : the variables are recorded every stride time steps.
+        \param rows (size_t) : number of records kept in the buffer before it has to be written.
+        \param communicator_ (Communicator*) : in the distributed mode, each process records the neurons it owns and *flush()* gathers the records.
+    */
+    Recorder(const Network& network, const std::string& probes, const std::string& variables=_PROBE_VARIABLES_, size_t stride_=_PROBE_STRIDE_, size_t rows=_PROBE_BUFFER_ROWS_, const Communicator* communicator_=nullptr);
+
+    /*! @brief Record the variables of the probes if the time is a multiple of the stride.
+        \param time (size_t) : the moment of the simulation to consider.
+    */
+    void record(size_t time);
+
+    /*! @name Display the records in an output file.
+        *header()* writes the name of each column (index.variable). *flush()* writes the records of the buffer and empties it (in the distributed mode, it must be called by all the processes and only the rank 0 writes).
+        \param outfile (ostream&) : the output file (suffix _probes).
+    */
+///@{
+    void header(std::ostream& outfile) const;
+    void flush(std::ostream& outfile);
+///@}
+
+    /*! @brief Remove the records of the buffer without writing them (once they have been read with *getRecords()*).
+    */
+    void clear();
+
+    /*! @brief Double the number of records the buffer can keep, without losing the records it has (used by \ref Simulation::step(), which does not write the buffer).
+    */
+    void grow();
+
+    /*!
+       @name Utility methods (getters)
+       *getRecords()* gives the records of the buffer : the value of variable \b k of probe \b p in record \b r is at index (r*probes+p)*variables+k.
+    */
+///@{
+    bool isFull() const;
+    size_t getNumberRecords() const;
+    const std::vector<double>& getRecords() const;
+    const std::vector<size_t>& getProbes() const;
+    const std::vector<Variable>& getVariables() const;
+///@}
+
+private:
+    std::vector<size_t> probes;
+    std::vector<const Neurone*> neurons;
+    ///false for the probes owned by another process
+    std::vector<bool> owned;
+    std::vector<Variable> variables;
+    size_t stride, capacity, used;
+    std::vector<size_t> times;
+    std::vector<double> records;
+    const Communicator* communicator;
+};
@@ -1,7 +1,14 @@
 #include "Simulation.h"
 #include "constants.h"
-
-Simulation::Simulation(int argc, char **argv)
+#include "Topology.h"
+#include <chrono>
+#include <thread>
+#include "AsyncOutput.h"
+#ifdef NEURONS_ZLIB
+#include "CompressedOutput.h"
+#endif
+
+Simulation::Simulation(int argc, char **argv, const Communicator* communicator_) : communicator(communicator_), time(0)
 {
     commandParse(argc,argv);
     char choice(_DEFAULT_CHOICE_);
@@ -27,16 +34,38 @@ Simulation::Simulation(int argc, char **argv)
     if(choice=='n') initializeRemainingAttributs(); // if we get 'y' we keep the defaults values for the attributs that were not mentionned by the user.
 
     checkValues(); //check the validity of all the values to be sure we can run the program properly
+    createNetwork();
+}
 
-    if(proportions.empty()) {
-        network = new Network(size, excitatoryProportion, meanConnectivity, meanIntensity, delta, networkModel);
-    } else {
-        loadConfiguration();
-        network = new Network(neuronsProportions, meanConnectivity, meanIntensity, delta, networkModel);
-    }
+Simulation::Simulation(const Configuration& configuration, const Communicator* communicator_) : communicator(communicator_), time(0)
+{
+    configure(configuration);
+    checkValues();
+    createNetwork();
+}
+
+void Simulation::createNetwork()
+{
+    if (pages!=NORMAL_PAGES or construction!=SHUFFLED_LINKS or weights!=DOUBLE_WEIGHTS) Network::resetPeakMemory(); // run() reports the peak memory of this construction
+    if(!proportions.empty()) loadConfiguration();
+    // with the plasticity, the links must stay in the neurons : a threshold above 1 never gives the dense matrix
+    network = newNetwork(weights, stdp ? 2.0 : denseThreshold);
+    if (stdp) network->enablePlasticity(); // the links are in the neurons, the plasticity updates them
+    if (accuracySteps>0 and weights!=DOUBLE_WEIGHTS) accuracy.reset(new Accuracy(newNetwork(DOUBLE_WEIGHTS, 2.0), *network, accuracySteps, _ACCURACY_WINDOW_)); // the same network, its links in double precision in the neurons
+}
+
+Network* Simulation::newNetwork(WeightPrecision precision, double threshold) const
+{
+    Network* created;
+    if(proportions.empty()) created = new Network(size, excitatoryProportion, meanConnectivity, meanIntensity, delta, networkModel, communicator, pages, seed, stream, construction, precision, rewiring, threshold);
+    else created = new Network(neuronsProportions, meanConnectivity, meanIntensity, delta, networkModel, communicator, pages, seed, stream, construction, precision, rewiring, threshold);
+    created->setIntegration(integration);
+    created->setSynapses(synapses);
+    if (!stimuliFile.empty()) created->enableStimuli()->load(stimuliFile, *created);
+    return created;
 }
 
-Simulation::Simulation() : network(new Network(_NEURON_NUMBER_, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_)), simulationDuration(_SIMULATION_TIME_), size(_NEURON_NUMBER_), excitatoryProportion(_PROPORTION_EXCITATOR_), meanIntensity(_MEAN_INTENSITY_), meanConnectivity(_MEAN_CONNECTIVITY_), delta(_DELTA_), outfileName(_OUTFILE_NAME_), networkModel(_NETWORK_MODEL_) // by default, additional fonctionalities are not used
+Simulation::Simulation() : network(new Network(_NEURON_NUMBER_, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_)), simulationDuration(_SIMULATION_TIME_), size(_NEURON_NUMBER_), weightsPeriod(_WEIGHTS_PERIOD_), statisticsWindow(_STATISTICS_WINDOW_), probeStride(_PROBE_STRIDE_), accuracySteps(_ACCURACY_STEPS_), quiescence(_QUIESCENCE_), steadyWindow(_STEADY_WINDOW_), excitatoryProportion(_PROPORTION_EXCITATOR_), meanIntensity(_MEAN_INTENSITY_), meanConnectivity(_MEAN_CONNECTIVITY_), delta(_DELTA_), denseThreshold(_DENSE_THRESHOLD_), rewiring(_REWIRING_), steadyVariance(_STEADY_VARIANCE_), pace(_PACE_), outfileName(_OUTFILE_NAME_), probes(_PROBES_), probeVariables(_PROBE_VARIABLES_), stimuliFile(""), metricsSocket(""), spikeRing(""), networkModel(_NETWORK_MODEL_), seed(_SEED_), stream(0), stdp(false), compression(false), spikesOutput(true), integration({ORIGINAL, _INTEGRATION_STEP_, _INTEGRATION_TOLERANCE_}), synapses({INSTANTANEOUS_SYNAPSES, _EXCITATORY_TAU_, _INHIBITORY_TAU_}), pages(NORMAL_PAGES), construction(SHUFFLED_LINKS), weights(DOUBLE_WEIGHTS), parametersFormat(TEXT_PARAMETERS), spikesFormat(RASTER_SPIKES), communicator(nullptr), time(0) // by default, additional fonctionalities are not used
 {} // Default values initialization
 
 Simulation::~Simulation()
@@ -73,22 +102,243 @@ void Simulation::commandParse(int argc, char **argv)
     TCLAP::ValueArg<double> delta_("d", "delta", _DELTA_TEXT_,  false, _DELTA_, "double");
     cmd.add(delta_);
 
-    std::vector<char> allowed{'B','C','O'} ; // define the constraints on the values that the networkModel can take
+    std::vector<char> allowed{'B','C','O','W','A'} ; // define the constraints on the values that the networkModel can take
     TCLAP::ValuesConstraint<char> allowedVals( allowed );
     TCLAP::ValueArg<char> network_model("M", "network_model", _NETWORK_MODEL_TEXT_, false, _NETWORK_MODEL_, &allowedVals);
     cmd.add(network_model);
 
+    TCLAP::ValueArg<double> rewiring_("r", "rewiring", _REWIRING_TEXT_, false, _REWIRING_, "double");
+    cmd.add(rewiring_);
+
+    TCLAP::SwitchArg stdp_("S", "stdp", _STDP_TEXT_, false);
+    cmd.add(stdp_);
+
+    TCLAP::SwitchArg compression_("Z", "compression", _COMPRESSION_TEXT_, false);
+    cmd.add(compression_);
+
+    TCLAP::ValueArg<size_t> statistics_window("A", "statistics", _STATISTICS_TEXT_, false, _STATISTICS_WINDOW_, "size_t");
+    cmd.add(statistics_window);
+
+    TCLAP::ValueArg<size_t> accuracy_steps("a", "accuracy", _ACCURACY_TEXT_, false, _ACCURACY_STEPS_, "size_t");
+    cmd.add(accuracy_steps);
+
+    TCLAP::ValueArg<size_t> quiescence_("q", "quiescence", _QUIESCENCE_TEXT_, false, _QUIESCENCE_, "size_t");
+    cmd.add(quiescence_);
+
+    TCLAP::ValueArg<size_t> steady_window("w", "steady_window", _STEADY_WINDOW_TEXT_, false, _STEADY_WINDOW_, "size_t");
+    cmd.add(steady_window);
+
+    TCLAP::ValueArg<double> steady_variance("v", "steady_variance", _STEADY_VARIANCE_TEXT_, false, _STEADY_VARIANCE_, "double");
+    cmd.add(steady_variance);
+
+    TCLAP::ValueArg<double> pace_("p", "pace", _PACE_TEXT_, false, _PACE_, "double");
+    cmd.add(pace_);
+
+    TCLAP::ValueArg<std::string> metrics_("m", "metrics", _METRICS_TEXT_, false, "", "string");
+    cmd.add(metrics_);
+
+    TCLAP::ValueArg<std::string> spike_ring("y", "spike_ring", _SPIKE_RING_TEXT_, false, "", "string");
+    cmd.add(spike_ring);
+
+    TCLAP::SwitchArg no_spikes("X", "no_spikes", _NO_SPIKES_TEXT_, false);
+    cmd.add(no_spikes);
+
+    TCLAP::ValueArg<std::string> stimuli_("U", "stimuli", _STIMULI_TEXT_, false, "", "string");
+    cmd.add(stimuli_);
+
+    TCLAP::ValueArg<std::string> probes_("L", "probes", _PROBES_TEXT_, false, _PROBES_, "string");
+    cmd.add(probes_);
+
+    TCLAP::ValueArg<std::string> probe_variables("V", "probe_variables", _PROBE_VARIABLES_TEXT_, false, _PROBE_VARIABLES_, "string");
+    cmd.add(probe_variables);
+
+    TCLAP::ValueArg<size_t> probe_stride("D", "probe_stride", _PROBE_STRIDE_TEXT_, false, _PROBE_STRIDE_, "size_t");
+    cmd.add(probe_stride);
+
+    TCLAP::ValueArg<size_t> weights_period("W", "weights_period", _WEIGHTS_PERIOD_TEXT_, false, _WEIGHTS_PERIOD_, "size_t");
+    cmd.add(weights_period);
+
+    std::vector<std::string> methods;
+    for (const auto& method : IntegrationMethods) methods.push_back(method.first);
+    TCLAP::ValuesConstraint<std::string> allowedMethods(methods);
+    TCLAP::ValueArg<std::string> integration_("R", "integration", _INTEGRATION_TEXT_, false, _INTEGRATION_, &allowedMethods);
+    cmd.add(integration_);
+
+    TCLAP::ValueArg<double> integration_step("H", "integration_step", _INTEGRATION_STEP_TEXT_, false, _INTEGRATION_STEP_, "double");
+    cmd.add(integration_step);
+
+    TCLAP::ValueArg<double> integration_tolerance("E", "integration_tolerance", _INTEGRATION_TOLERANCE_TEXT_, false, _INTEGRATION_TOLERANCE_, "double");
+    cmd.add(integration_tolerance);
+
+    std::vector<std::string> synapseModels;
+    for (const auto& model : SynapseModels) synapseModels.push_back(model.first);
+    TCLAP::ValuesConstraint<std::string> allowedSynapses(synapseModels);
+    TCLAP::ValueArg<std::string> synapses_("e", "synapses", _SYNAPSES_TEXT_, false, _SYNAPSES_, &allowedSynapses);
+    cmd.add(synapses_);
+
+    TCLAP::ValueArg<double> excitatory_tau("c", "excitatory_tau", _EXCITATORY_TAU_TEXT_, false, _EXCITATORY_TAU_, "double");
+    cmd.add(excitatory_tau);
+
+    TCLAP::ValueArg<double> inhibitory_tau("i", "inhibitory_tau", _INHIBITORY_TAU_TEXT_, false, _INHIBITORY_TAU_, "double");
+    cmd.add(inhibitory_tau);
+
+    std::vector<std::string> pageModes;
+    for (const auto& mode : PageModes) pageModes.push_back(mode.first);
+    TCLAP::ValuesConstraint<std::string> allowedPages(pageModes);
+    TCLAP::ValueArg<std::string> pages_("G", "pages", _PAGES_TEXT_, false, _PAGES_, &allowedPages);
+    cmd.add(pages_);
+
+    std::vector<std::string> constructions;
+    for (const auto& mode : Constructions) constructions.push_back(mode.first);
+    TCLAP::ValuesConstraint<std::string> allowedConstructions(constructions);
+    TCLAP::ValueArg<std::string> construction_("B", "construction", _CONSTRUCTION_TEXT_, false, _CONSTRUCTION_, &allowedConstructions);
+    cmd.add(construction_);
+
+    std::vector<std::string> precisions;
+    for (const auto& precision : WeightPrecisions) precisions.push_back(precision.first);
+    TCLAP::ValuesConstraint<std::string> allowedPrecisions(precisions);
+    TCLAP::ValueArg<std::string> weights_("Q", "weights", _WEIGHTS_TEXT_, false, _WEIGHTS_, &allowedPrecisions);
+    cmd.add(weights_);
+
+    std::vector<std::string> parametersFormats;
+    for (const auto& format : ParametersFormats) parametersFormats.push_back(format.first);
+    TCLAP::ValuesConstraint<std::string> allowedParametersFormats(parametersFormats);
+    TCLAP::ValueArg<std::string> parameters_format("F", "parameters_format", _PARAMETERS_FORMAT_TEXT_, false, _PARAMETERS_FORMAT_, &allowedParametersFormats);
+    cmd.add(parameters_format);
+
+    std::vector<std::string> spikesFormats;
+    for (const auto& format : SpikesFormats) spikesFormats.push_back(format.first);
+    TCLAP::ValuesConstraint<std::string> allowedSpikesFormats(spikesFormats);
+    TCLAP::ValueArg<std::string> spikes_format("K", "spikes_format", _SPIKES_FORMAT_TEXT_, false, _SPIKES_FORMAT_, &allowedSpikesFormats);
+    cmd.add(spikes_format);
+
+    TCLAP::ValueArg<double> dense_threshold("J", "dense_threshold", _DENSE_THRESHOLD_TEXT_, false, _DENSE_THRESHOLD_, "double");
+    cmd.add(dense_threshold);
+
+    TCLAP::ValueArg<unsigned long int> seed_("s", "seed", _SEED_TEXT_, false, _SEED_, "unsigned long");
+    cmd.add(seed_);
+
     cmd.parse(argc, argv);
 
-    size=neuron_number.getValue();
-    simulationDuration=simulation_time.getValue();
-    excitatoryProportion=proportion_excitator.getValue();
-    meanConnectivity=mean_connectivity.getValue();
-    meanIntensity=mean_intensity.getValue();
-    proportions=types_proportions.getValue();
-    delta=delta_.getValue();
-    networkModel= network_model.getValue();
-    outfileName=output.getValue();
+    Configuration configuration;
+    configuration.neuronNumber=neuron_number.getValue();
+    configuration.duration=simulation_time.getValue();
+    configuration.excitatoryProportion=proportion_excitator.getValue();
+    configuration.meanConnectivity=mean_connectivity.getValue();
+    configuration.meanIntensity=mean_intensity.getValue();
+    configuration.proportions=types_proportions.getValue();
+    configuration.delta=delta_.getValue();
+    configuration.networkModel=network_model.getValue();
+    configuration.rewiring=rewiring_.getValue();
+    configuration.seed=seed_.getValue();
+    configuration.outfileName=output.getValue();
+    configuration.stdp=stdp_.getValue();
+    configuration.weightsPeriod=weights_period.getValue();
+    configuration.compression=compression_.getValue();
+    configuration.statisticsWindow=statistics_window.getValue();
+    configuration.accuracySteps=accuracy_steps.getValue();
+    configuration.quiescence=quiescence_.getValue();
+    configuration.steadyWindow=steady_window.getValue();
+    configuration.steadyVariance=steady_variance.getValue();
+    configuration.pace=pace_.getValue();
+    configuration.metricsSocket=metrics_.getValue();
+    configuration.spikeRing=spike_ring.getValue();
+    configuration.spikesOutput=!no_spikes.getValue();
+    configuration.stimuli=stimuli_.getValue();
+    configuration.probes=probes_.getValue();
+    configuration.probeVariables=probe_variables.getValue();
+    configuration.probeStride=probe_stride.getValue();
+    configuration.pages=PageModes.at(pages_.getValue());
+    configuration.construction=Constructions.at(construction_.getValue());
+    configuration.weights=WeightPrecisions.at(weights_.getValue());
+    configuration.parametersFormat=ParametersFormats.at(parameters_format.getValue());
+    configuration.spikesFormat=SpikesFormats.at(spikes_format.getValue());
+    configuration.denseThreshold=dense_threshold.getValue();
+    configuration.integration={IntegrationMethods.at(integration_.getValue()), integration_step.getValue(), integration_tolerance.getValue()};
+    configuration.synapses={SynapseModels.at(synapses_.getValue()), excitatory_tau.getValue(), inhibitory_tau.getValue()};
+    configure(configuration);
+}
+
+void Simulation::configure(const Configuration& configuration)
+{
+    size=configuration.neuronNumber;
+    simulationDuration=configuration.duration;
+    excitatoryProportion=configuration.excitatoryProportion;
+    meanConnectivity=configuration.meanConnectivity;
+    meanIntensity=configuration.meanIntensity;
+    proportions=configuration.proportions;
+    delta=configuration.delta;
+    networkModel=configuration.networkModel;
+    rewiring=configuration.rewiring;
+    seed=configuration.seed;
+    stream=configuration.stream;
+    outfileName=configuration.outfileName;
+    stdp=configuration.stdp;
+    weightsPeriod=configuration.weightsPeriod;
+    compression=configuration.compression;
+    statisticsWindow=configuration.statisticsWindow;
+    accuracySteps=configuration.accuracySteps;
+    quiescence=configuration.quiescence;
+    steadyWindow=configuration.steadyWindow;
+    steadyVariance=configuration.steadyVariance;
+    pace=configuration.pace;
+    metricsSocket=configuration.metricsSocket;
+    spikeRing=configuration.spikeRing;
+    spikesOutput=configuration.spikesOutput;
+    stimuliFile=configuration.stimuli;
+    probes=configuration.probes;
+    probeVariables=configuration.probeVariables;
+    probeStride=configuration.probeStride;
+    pages=configuration.pages;
+    construction=configuration.construction;
+    weights=configuration.weights;
+    parametersFormat=configuration.parametersFormat;
+    spikesFormat=configuration.spikesFormat;
+    denseThreshold=configuration.denseThreshold;
+    integration=configuration.integration;
+    synapses=configuration.synapses;
+}
+
+Configuration Simulation::getConfiguration() const
+{
+    Configuration configuration;
+    configuration.neuronNumber=size;
+    configuration.duration=simulationDuration;
+    configuration.excitatoryProportion=excitatoryProportion;
+    configuration.meanConnectivity=meanConnectivity;
+    configuration.meanIntensity=meanIntensity;
+    configuration.proportions=proportions;
+    configuration.delta=delta;
+    configuration.networkModel=networkModel;
+    configuration.rewiring=rewiring;
+    configuration.seed=seed;
+    configuration.stream=stream;
+    configuration.outfileName=outfileName;
+    configuration.stdp=stdp;
+    configuration.weightsPeriod=weightsPeriod;
+    configuration.compression=compression;
+    configuration.statisticsWindow=statisticsWindow;
+    configuration.accuracySteps=accuracySteps;
+    configuration.quiescence=quiescence;
+    configuration.steadyWindow=steadyWindow;
+    configuration.steadyVariance=steadyVariance;
+    configuration.pace=pace;
+    configuration.metricsSocket=metricsSocket;
+    configuration.spikeRing=spikeRing;
+    configuration.spikesOutput=spikesOutput;
+    configuration.stimuli=stimuliFile;
+    configuration.probes=probes;
+    configuration.probeVariables=probeVariables;
+    configuration.probeStride=probeStride;
+    configuration.pages=pages;
+    configuration.construction=construction;
+    configuration.weights=weights;
+    configuration.parametersFormat=parametersFormat;
+    configuration.spikesFormat=spikesFormat;
+    configuration.denseThreshold=denseThreshold;
+    configuration.integration=integration;
+    configuration.synapses=synapses;
+    return configuration;
 }
 
 void Simulation::initializeRemainingAttributs()
@@ -196,6 +446,88 @@ void Simulation::checkValues() //since we don't want to stop the program when a
         std::cerr << "The delta parameter used in the additional functionality must be between 0 and 1 because the 'noise' that affect each parameter must be approximately 1. The default value " + std::to_string(_DELTA_) + " will be used instead of the one you gave (i.e. this fonctionnality will not be used). \n" << std::endl;
     }
 
+    if (integration.step<=0.0 or integration.step>_DT_) {
+        integration.step=_INTEGRATION_STEP_;
+        std::cerr << "The integration step must be positive and can not exceed the time step. The default value " + std::to_string(_INTEGRATION_STEP_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (integration.tolerance<=0.0) {
+        integration.tolerance=_INTEGRATION_TOLERANCE_;
+        std::cerr << "The tolerance of the adaptive integration must be positive. The default value " + std::to_string(_INTEGRATION_TOLERANCE_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (synapses.excitatoryTau<=0.0) {
+        synapses.excitatoryTau=_EXCITATORY_TAU_;
+        std::cerr << "The decay time of the excitatory synapses must be positive. The default value " + std::to_string(_EXCITATORY_TAU_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (synapses.inhibitoryTau<=0.0) {
+        synapses.inhibitoryTau=_INHIBITORY_TAU_;
+        std::cerr << "The decay time of the inhibitory synapses must be positive. The default value " + std::to_string(_INHIBITORY_TAU_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (seed==0 and communicator and communicator->getSize()>1) {
+        seed=_SEED_;
+        std::cerr << "All the processes must use the same seed, a random seed can not be used in the distributed mode. The default value " + std::to_string(_SEED_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (accuracySteps>0 and weights==DOUBLE_WEIGHTS) {
+        accuracySteps=0;
+        std::cerr << "The accuracy report compares the quantized links (option -Q) with the double precision, it is not made with links in double precision. \n" << std::endl;
+    }
+
+    if (steadyVariance<0.0) {
+        steadyVariance=_STEADY_VARIANCE_;
+        std::cerr << "The variance threshold of the steady state must be positive. The default value " + std::to_string(_STEADY_VARIANCE_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (rewiring<0.0 or rewiring>1.0) {
+        rewiring=_REWIRING_;
+        std::cerr << "The rewiring probability must be between 0 and 1. The default value " + std::to_string(_REWIRING_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (Topology::isStructured(networkModel) and construction==PROCEDURAL_LINKS) {
+        construction=STREAMED_LINKS;
+        std::cerr << "The links of the small-world and scale-free networks are drawn all at once, they can not be computed again at each time-step. The links will be streamed instead of procedural. \n" << std::endl;
+    }
+
+    if (stdp and construction==PROCEDURAL_LINKS) {
+        construction=STREAMED_LINKS;
+        std::cerr << "The plasticity needs stored links. The links will be streamed instead of procedural. \n" << std::endl;
+    }
+
+    if (construction==PROCEDURAL_LINKS and weights!=DOUBLE_WEIGHTS) {
+        weights=DOUBLE_WEIGHTS;
+        std::cerr << "The procedural links are not stored, their strengths can not be quantized. The strengths will be doubles instead of the precision you gave. \n" << std::endl;
+    }
+
+    if (stdp and weights!=DOUBLE_WEIGHTS) {
+        weights=DOUBLE_WEIGHTS;
+        std::cerr << "The plasticity needs the strengths of the links in double precision. The strengths will be doubles instead of the precision you gave. \n" << std::endl;
+    }
+
+    if (denseThreshold<0.0) {
+        denseThreshold=_DENSE_THRESHOLD_;
+        std::cerr << "The density above which the links are stored in a dense matrix can not be negative. The default value " + std::to_string(_DENSE_THRESHOLD_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+    if (pace<0.0) {
+        pace=_PACE_;
+        std::cerr << "The pace of the simulation can not be negative. The simulation will run as fast as possible instead of the pace you gave. \n" << std::endl;
+    }
+
+    if (probeStride==0) {
+        probeStride=_PROBE_STRIDE_;
+        std::cerr << "The probes must be recorded at least every time step. The default value " + std::to_string(_PROBE_STRIDE_) + " will be used instead of the one you gave. \n" << std::endl;
+    }
+
+#ifndef NEURONS_ZLIB
+    if (compression) {
+        compression=false;
+        std::cerr << "The program was compiled without zlib, the output files can not be compressed. They will be written as text files. \n" << std::endl;
+    }
+#endif
+
     if (simulationDuration>10000) {
         simulationDuration=_SIMULATION_TIME_;
         std::cerr << "The time is very big, this can be due to a negative time given. The default value " + std::to_string(_SIMULATION_TIME_) + " will be used instead of the one you gave. \n" << std::endl;
@@ -214,38 +546,182 @@ bool Simulation::typeExists(std::string type) const
 
 size_t Simulation::run()
 {
-    std::ofstream outfileSpikes,outfileParam, outfileSample;
-    outfileSpikes.open(outfileName+"_spikes.txt", std::ios_base::out);
-    if (!outfileSpikes.good()) throw(OUTPUT_ERROR(std::string("The spikes output file is not in good condition, it is impossible to write on it. The spikes results will be written on the terminal. \n")));
-    std::ostream *outstream = &std::cout; //if the file is not open, we print the results in the terminal (we only print the spikes results on the terminal because it is the main result file)
-    if (outfileSpikes.is_open()) outstream = &outfileSpikes;
-
-    outfileParam.open(outfileName+"_parameters.txt");
-    if (!outfileParam.good()) throw(OUTPUT_ERROR(std::string("The parameters output file is not in good condition, it is impossible to write on it. This results will not be displayed. \n")));
+    bool root(!communicator or communicator->isRoot()); // in the distributed mode, only the rank 0 writes the output files
+    std::unique_ptr<std::ostream> outfileSpikes;
+    if (spikesOutput) outfileSpikes = openOutput("_spikes.txt", "The spikes output file is not in good condition, it is impossible to write on it. \n");
+    std::unique_ptr<std::ostream> outfileSample(openOutput("_sample_neurons.txt", "The neurons sample output file is not in good condition, it is impossible to write on it. This results will not be displayed. \n"));
 
-    outfileSample.open(outfileName+"_sample_neurons.txt");
-    if (!outfileSample.good()) throw(OUTPUT_ERROR(std::string("The neurons sample output file is not in good condition, it is impossible to write on it. This results will not be displayed. \n")));
+// with huge pages, the streamed or procedural construction, the quantized links or the dense matrix, tell where the memory of the network is and how much the construction took
+    if (pages!=NORMAL_PAGES or construction!=SHUFFLED_LINKS or weights!=DOUBLE_WEIGHTS or network->hasDenseLinks()) network->printMemory(std::cout);
 
 // fill the parameters files
-    network->headerParameters(outfileParam);
-    network->printParameters(outfileParam);
-    if (outfileParam.is_open()) outfileParam.close();
+    if (parametersFormat==COLUMN_PARAMETERS) {
+        ParameterColumns columns(*network, communicator);
+        if (root) {
+            std::ofstream outfileColumns(outfileName+"_parameters.bin", std::ios_base::out | std::ios_base::binary);
+            if (!outfileColumns.good()) throw(OUTPUT_ERROR(std::string("The parameters output file is not in good condition, it is impossible to write on it. \n")));
+            columns.write(outfileColumns);
+        }
+    } else {
+        std::unique_ptr<std::ostream> outfileParam(openOutput("_parameters.txt", "The parameters output file is not in good condition, it is impossible to write on it. This results will not be displayed. \n"));
+        if (root) network->headerParameters(*outfileParam);
+        network->printParameters(*outfileParam);
+        closeOutput(outfileParam);
+    }
+
+// print the header for sample output file (and for the spikes output file, if it has one)
+    if (root) network->headerSample(*outfileSample);
+    if (root and outfileSpikes) network->headerSpikes(*outfileSpikes, spikesFormat);
+
+// the strengths of the links are only written if they evolve during the simulation (in the distributed mode, each process writes the links it stores in its own file)
+    std::unique_ptr<std::ostream> outfileWeights;
+    if (network->getPlasticity() and weightsPeriod>0) {
+        std::string suffix(communicator and communicator->getSize()>1 ? "_weights_rank" + std::to_string(communicator->getRank()) + ".bin" : "_weights.bin");
+        if (pace>0.0) outfileWeights.reset(new AsyncOutput(outfileName+suffix, _TEXT_BUFFER_SIZE_, _OUTPUT_QUEUE_, std::ios_base::out | std::ios_base::binary));
+        else outfileWeights.reset(new std::ofstream(outfileName+suffix, std::ios_base::out | std::ios_base::binary));
+        if (!outfileWeights->good()) throw(OUTPUT_ERROR(std::string("The weights output file is not in good condition, it is impossible to write on it. \n")));
+    }
+
+// the statistics are updated at each time step and written at the end, the probes are recorded in a buffer which is written when it is full
+    start();
+    std::unique_ptr<std::ostream> outfileProbes;
+    if (recorder) {
+        outfileProbes = openOutput("_probes.txt", "The probes output file is not in good condition, it is impossible to write on it. \n");
+        if (root) recorder->header(*outfileProbes);
+    }
 
-// print the header for sample output file
-    network->headerSample(outfileSample);
+// with a pace, each time step starts at its time on the wall-clock and its latency is measured before the output files are written
+    std::chrono::nanoseconds period(0);
+    if (pace>0.0) {
+        period = std::chrono::nanoseconds(std::llround(1e6*_DT_/pace));
+        latencies.reset(new LatencyHistogram(period.count()));
+    }
+    std::chrono::steady_clock::time_point scheduled(std::chrono::steady_clock::now());
 
 // print both the spikes and sample output files
-    size_t current_time(1); // we start a t=1
-    while(current_time <= simulationDuration) {
+    TextBuffer spikesText, sampleText; // the lines are formatted in large buffers, written when they are full
+    auto write = [](TextBuffer& text, std::ostream& outfile) {
+        AsyncOutput* async(dynamic_cast<AsyncOutput*>(&outfile));
+        if (async) async->submit(text); // with a pace, the buffer is only exchanged with a written one
+        else text.write(outfile);
+    };
+    while(time < simulationDuration and !(earlyStop and earlyStop->isStopped())) {
+        size_t current_time(step()); // we start a t=1
+        if (latencies) {
+            latencies->record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-scheduled).count());
+            scheduled += period;
+        }
+        if (root and outfileSpikes) {
+            network->printSpikes(spikesText, current_time, spikesFormat);
+            if (spikesText.isFull()) write(spikesText, *outfileSpikes);
+        }
+        network->printSample(sampleText, current_time); // the other ranks send the values of the neurons they own
+        if (sampleText.isFull()) write(sampleText, *outfileSample);
+        if (recorder and recorder->isFull()) recorder->flush(*outfileProbes);
+        if (outfileWeights and current_time%weightsPeriod==0) network->getPlasticity()->dumpWeights(*outfileWeights, current_time);
+        if (latencies) std::this_thread::sleep_until(scheduled);
+    }
+    if (outfileSpikes) {
+        write(spikesText, *outfileSpikes);
+        closeOutput(outfileSpikes);
+    }
+    if (outfileWeights) closeOutput(outfileWeights);
+    write(sampleText, *outfileSample);
+    closeOutput(outfileSample);
+    if (recorder) {
+        recorder->flush(*outfileProbes);
+        closeOutput(outfileProbes);
+    }
+
+    if (latencies) {
+        std::unique_ptr<std::ostream> outfileLatency(openOutput("_latency.txt", "The latency output file is not in good condition, it is impossible to write on it. \n"));
+        if (root) {
+            latencies->print(*outfileLatency);
+            std::cout << "paced run : " << latencies->getCount() << " time steps, " << latencies->getMisses() << " deadline misses (deadline " << period.count()/1e6 << " ms), latency p50 " << latencies->getPercentile(50)/1e6 << " ms, p99 " << latencies->getPercentile(99)/1e6 << " ms, p99.9 " << latencies->getPercentile(99.9)/1e6 << " ms, max " << latencies->getMaximum()/1e6 << " ms" << std::endl;
+        }
+        closeOutput(outfileLatency);
+    }
+
+    if (earlyStop) {
+        std::unique_ptr<std::ostream> outfileStop(openOutput("_stop.txt", "The stop output file is not in good condition, it is impossible to write on it. \n"));
+        if (root) {
+            earlyStop->print(*outfileStop, simulationDuration);
+            if (earlyStop->isStopped()) earlyStop->print(std::cout, simulationDuration);
+        }
+        closeOutput(outfileStop);
+    }
+
+    if (accuracy) {
+        std::unique_ptr<std::ostream> outfileAccuracy(openOutput("_accuracy.txt", "The accuracy output file is not in good condition, it is impossible to write on it. \n"));
+        if (root) accuracy->print(*outfileAccuracy);
+        closeOutput(outfileAccuracy);
+    }
+
+    if (statistics) {
+        std::unique_ptr<std::ostream> outfileStatistics(openOutput("_statistics.txt", "The statistics output file is not in good condition, it is impossible to write on it. \n"));
+        if (root) statistics->print(*outfileStatistics);
+        closeOutput(outfileStatistics);
+    }
+
+    return time;
+}
+
+void Simulation::start()
+{
+    if (statisticsWindow>0 and !statistics) statistics.reset(new Statistics(*network, statisticsWindow));
+    if (!probes.empty() and !recorder) recorder.reset(new Recorder(*network, probes, probeVariables, probeStride, _PROBE_BUFFER_ROWS_, communicator));
+    if (!metricsSocket.empty() and !metrics and (!communicator or communicator->isRoot())) metrics.reset(new MetricsServer(metricsSocket, *network, simulationDuration, outfileName)); // the rank 0 knows all the spikes
+    if (!spikeRing.empty() and !ring and (!communicator or communicator->isRoot())) ring.reset(new SpikeRing(spikeRing, size));
+    if ((quiescence>0 or steadyWindow>0) and !earlyStop) earlyStop.reset(new EarlyStop(network->getNumberNeurons(), quiescence, steadyWindow, steadyVariance)); // every rank knows all the spikes and stops at the same time step
+}
+
+size_t Simulation::step(size_t steps)
+{
+    start();
+    for (size_t s(0); s<steps and !(earlyStop and earlyStop->isStopped()); ++s) {
         network->update();
-        network->printSpikes(*outstream, current_time);
-        if (outfileSample.is_open()) network->printSample(outfileSample, current_time);
-        current_time += _DT_;
+        time += _DT_;
+        if (statistics) statistics->record(network->getFired(), time);
+        if (recorder) {
+            if (recorder->isFull()) recorder->grow(); // run() writes the buffer once it is full, a library client reads it when it wants
+            recorder->record(time);
+        }
+        if (metrics) metrics->record(network->getFired(), time);
+        if (ring) ring->publish(time, network->getFired());
+        if (earlyStop) earlyStop->record(network->getFired().size(), time);
+        if (accuracy) accuracy->record(network->getFired(), time);
     }
-    if (outfileSpikes.is_open()) outfileSpikes.close();
-    if (outfileSample.is_open()) outfileSample.close();
+    return time;
+}
 
-    return current_time-1; // the while loop increments the time counter 1 time too much, the real duration is thus current_time-1
+std::unique_ptr<std::ostream> Simulation::openOutput(const std::string& suffix, const std::string& error) const
+{
+    if (communicator and !communicator->isRoot()) return std::unique_ptr<std::ostream>(new std::ofstream()); // the other ranks get a closed stream, nothing is written in it
+
+    if (compression) {
+#ifdef NEURONS_ZLIB
+        CompressedOutput* compressed(new CompressedOutput(outfileName+suffix+".gz"));
+        std::unique_ptr<std::ostream> outfile(compressed);
+        if (!compressed->is_open()) throw(OUTPUT_ERROR(error));
+        return outfile;
+#endif
+    }
+    if (pace>0.0) { // the paced loop must not wait for the disk
+        AsyncOutput* async(new AsyncOutput(outfileName+suffix));
+        std::unique_ptr<std::ostream> outfile(async);
+        if (!async->is_open()) throw(OUTPUT_ERROR(error));
+        return outfile;
+    }
+    std::unique_ptr<std::ostream> outfile(new std::ofstream(outfileName+suffix));
+    if (!outfile->good()) throw(OUTPUT_ERROR(error));
+    return outfile;
+}
+
+void Simulation::closeOutput(std::unique_ptr<std::ostream>& outfile)
+{
+    AsyncOutput* async(dynamic_cast<AsyncOutput*>(outfile.get()));
+    if (async) async->close(); // waits for the last blocks and reports the errors of the worker thread
+    outfile.reset();
 }
 
 Network* Simulation::getNetwork() const
@@ -253,7 +729,7 @@ Network* Simulation::getNetwork() const
     return network;
 }
 
-std::map<std::string, size_t>  Simulation::getNeuronsProportions()
+const std::map<std::string, size_t>& Simulation::getNeuronsProportions() const
 {
     return neuronsProportions;
 }
@@ -263,6 +739,69 @@ size_t Simulation::getSimulationDuration() const
     return simulationDuration;
 }
 
+size_t Simulation::getTime() const
+{
+    return time;
+}
+
+Statistics* Simulation::getStatistics() const
+{
+    return statistics.get();
+}
+
+LatencyHistogram* Simulation::getLatencies() const
+{
+    return latencies.get();
+}
+
+MetricsServer* Simulation::getMetrics() const
+{
+    return metrics.get();
+}
+
+SpikeRing* Simulation::getSpikeRing() const
+{
+    return ring.get();
+}
+
+EarlyStop* Simulation::getEarlyStop() const
+{
+    return earlyStop.get();
+}
+
+Accuracy* Simulation::getAccuracy() const
+{
+    return accuracy.get();
+}
+
+Recorder* Simulation::getRecorder() const
+{
+    return recorder.get();
+}
+
+void Simulation::setWeightsPeriod(size_t period)
+{
+    weightsPeriod = period;
+}
+
+void Simulation::setCompression(bool compression_)
+{
+    compression = compression_;
+}
+
+void Simulation::setStatistics(size_t window, bool spikes)
+{
+    statisticsWindow = window;
+    spikesOutput = spikes;
+}
+
+void Simulation::setProbes(const std::string& probes_, const std::string& variables, size_t stride)
+{
+    probes = probes_;
+    probeVariables = variables;
+    probeStride = stride;
+}
+
 void Simulation::setProportions(std::string prop)
 {
     proportions = prop;
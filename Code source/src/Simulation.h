@@ -1,4 +1,14 @@
+#pragma once
 #include "Network.h"
+#include "Statistics.h"
+#include "Recorder.h"
+#include "ParameterColumns.h"
+#include "LatencyHistogram.h"
+#include "MetricsServer.h"
+#include "SpikeRing.h"
+#include "EarlyStop.h"
+#include "Accuracy.h"
+#include <memory>
 
 /*! @class Simulation
 
@@ -8,6 +18,8 @@
 
    A Simulation is mainly made of a number of time steps \ref simulationDuration and a \ref Network, which contains pointers to \ref Neurone objects. These neurons are constructed and linked randomly. The simulation is either created according to user inputs or with default values.
 
+   The Simulation can also be used as a library (libneurons) : it is then built from a \ref Configuration, advanced with *step()*, and the results are read directly (firing state and spikes of the last time step in the \ref Network, records of the probes in the \ref Recorder, summary of the activity in the \ref Statistics) without output files.
+
    The map \ref neuronsProportions describes the neuron population (see \ref constants.h) :
    The key is the neuron type from \ref Neuron::NeuronTypes and the associated value is the number of this neuron type in the simulation.
 */
@@ -21,9 +33,12 @@ public:
      * @name Construction and destruction
         Create the \ref Simulation according to values entered via the command line by the user or create it using the default values. If the user don't enter a value for each parameter, a message is deplayed on the terminal to explain how to use the program and help the user.
      *  The constructor uses *commandParse()* to process user inputs with TCLAP and construct the simulation with the right values.
+     *  The constructor from a \ref Configuration does not read the command line and does not ask anything to the user.
+     *  In the distributed mode, the \ref Communicator tells which neurons are owned by this process (see \ref Network::Network()).
      */
 ///@{
-    Simulation(int argc, char **argv);
+    Simulation(int argc, char **argv, const Communicator* communicator_=nullptr);
+    Simulation(const Configuration& configuration, const Communicator* communicator_=nullptr);
     Simulation();
     ~Simulation();
 ///@}
@@ -38,6 +53,12 @@ public:
     */
     void commandParse(int argc, char **argv);
 
+    /*!
+     * @brief *configure()* initializes the attributs with the values of a \ref Configuration (the network is not built again), *getConfiguration()* gives the current values.
+    */
+    void configure(const Configuration& configuration);
+    Configuration getConfiguration() const;
+
     /*!
      * @brief This method is called in case the user execute the program without all the parameters required by mistakes. Thus, it allows him to initialize the ones he forgot to initialize and let the others to their default values. If the user doesn't enter any values, by defaul this method will only permit him to use this program in its easiest way. Here are the possible values to chose : the duration of the simulation, the total number of neurons, the proportion of excitatory neurons, the mean intensity of the connections and the mean number of connections between each neurons.
     */
@@ -64,10 +85,31 @@ public:
     /*!@name Run the Simulation
      */
 ///@{
-    /*! @brief This method is the most important of the \ref Simulation class. It runs the simulation with a loop until the requested simulation duration is reached. At each new time step, the Simulation updates its network, so updates indirectly each neurons of its \ref Network. Moreover, it prints the results on 3 output file (the spikes \ref Network::printSpikes(), the parameters of each neuron  \ref Network::printParameters(), and the membrane potential, recovery variable and current of one neurone of each type present in the simulation  \ref Network::printSample()).
+    /*! @brief This method is the most important of the \ref Simulation class. It runs the simulation with a loop until the requested simulation duration is reached. At each new time step, the Simulation updates its network, so updates indirectly each neurons of its \ref Network. Moreover, it prints the results on 3 output file (the spikes \ref Network::printSpikes(), the parameters of each neuron  \ref Network::printParameters(), and the membrane potential, recovery variable and current of one neurone of each type present in the simulation  \ref Network::printSample()). If probes are given, their time dependent variables are recorded (see \ref Recorder). If a statistics window is given, a summary of the activity is computed during the simulation and written at the end (see \ref Statistics); the spikes output file can then be disabled. If the links are plastic and a weights period is given, the strengths of all the links are also written every weights period in the binary file which name has the suffix _weights.bin (see \ref Plasticity::dumpWeights()).
+     * If a metrics socket is given, the progress of the simulation is served on it during the run (see \ref MetricsServer). If a shared memory name is given, the spikes of each time step are published in it (see \ref SpikeRing).
+     * With stopping criteria (quiescence or steady state, see \ref EarlyStop), the simulation ends as soon as one of them is met, the output files then stop at this time step, and the reason is written on the terminal and in the output file which name has the suffix _stop.
+     * With quantized links and an accuracy report (see \ref Accuracy), the same network in double precision is simulated beside it during the first time steps, and their firing statistics are compared in the output file which name has the suffix _accuracy.
+     * With a pace, the time step \b k starts at the time (k-1) / pace ms after the first one on the wall-clock (the simulation sleeps until then if it is early, and does not wait if it is late), and its latency, from this time to the end of *step()*, is counted in a \ref LatencyHistogram. The output files are then written by worker threads (see \ref AsyncOutput) : the loop only exchanges the full text buffers with written ones, and copies the probes and the strengths of the links in blocks, so it only waits for the disk if the writing falls behind by more than a few blocks; no memory is allocated in the loop once the buffers have their size. The latency histogram is written at the end in the output file which name has the suffix _latency, and summarized on the terminal.
      * @return the time the simulation lasted.
     */
     size_t run();
+
+    /*! @brief Advance the simulation without writing the output files : updates the network and records the statistics, the probes and the metrics, and publishes the spikes in shared memory, if they are requested. The records of the probes stay in the buffer of the \ref Recorder, which grows when it is full, until they are read and removed (\ref Recorder::getRecords() and \ref Recorder::clear()).
+     * With stopping criteria, it stops before the given number of time steps once a criterion is met (see *getEarlyStop()*).
+     * @param steps (size_t) : number of time steps.
+     * @return the current time step.
+    */
+    size_t step(size_t steps=1);
+
+    /*! @brief Open the output file which name is the output name followed by the given suffix : a text file, a text file written by a worker thread (\ref AsyncOutput) if the simulation is paced, or a gzip file (\ref CompressedOutput, suffix .gz added) if the compression is used. In the distributed mode, the ranks other than 0 get a closed stream.
+     * @param suffix (string) : suffix of the file name.
+     * @param error (string) : message of the error thrown if the file can not be opened.
+    */
+    std::unique_ptr<std::ostream> openOutput(const std::string& suffix, const std::string& error) const;
+
+    /*! @brief Close and destroy an output file opened with *openOutput()*.
+    */
+    static void closeOutput(std::unique_ptr<std::ostream>& outfile);
 ///@}
 
     /*!
@@ -75,8 +117,23 @@ public:
     */
 ///@{
     Network* getNetwork() const;
-    std::map<std::string, size_t>  getNeuronsProportions();
+    /// number of neurons of each type given by the user (empty with an excitatory proportion), without copy
+    const std::map<std::string, size_t>& getNeuronsProportions() const;
     size_t getSimulationDuration()const;
+    size_t getTime() const;
+    /// nullptr if no statistics, probes or pace are requested
+    Statistics* getStatistics() const;
+    Recorder* getRecorder() const;
+    LatencyHistogram* getLatencies() const;
+    MetricsServer* getMetrics() const;
+    SpikeRing* getSpikeRing() const;
+    EarlyStop* getEarlyStop() const;
+    /// comparison of the quantized links with the double precision, nullptr without it
+    Accuracy* getAccuracy() const;
+    void setWeightsPeriod(size_t period);
+    void setCompression(bool compression_);
+    void setStatistics(size_t window, bool spikes=true);
+    void setProbes(const std::string& probes_, const std::string& variables=_PROBE_VARIABLES_, size_t stride=_PROBE_STRIDE_);
     void setProportions(std::string prop);
     static bool isApostrophe(char c);
 
@@ -88,11 +145,37 @@ public:
 ///@}
 
 private:
+    /// build the network with the values of the attributs (the peak memory of the process is reset before when *run()* reports the construction)
+    void createNetwork();
+    /// a network built with the values of the attributs, with the given precision of the links and density threshold of the dense matrix
+    Network* newNetwork(WeightPrecision precision, double threshold) const;
+    /// create the statistics, the recorder, the metrics server, the shared memory of the spikes and the stopping criteria before the first time step
+    void start();
 
     Network* network;
-    size_t simulationDuration, size;
-    double excitatoryProportion, meanIntensity, meanConnectivity, delta;
-    std::string outfileName, proportions;
+    size_t simulationDuration, size, weightsPeriod, statisticsWindow, probeStride, accuracySteps, quiescence, steadyWindow;
+    double excitatoryProportion, meanIntensity, meanConnectivity, delta, denseThreshold, rewiring, steadyVariance, pace;
+    std::string outfileName, proportions, probes, probeVariables, stimuliFile, metricsSocket, spikeRing;
     std::map< std::string, size_t > neuronsProportions;
     char networkModel ;
+    unsigned long int seed, stream;
+    bool stdp, compression, spikesOutput;
+    Integration integration;
+    Synapses synapses;
+    PageMode pages;
+    Construction construction;
+    WeightPrecision weights;
+    ParametersFormat parametersFormat;
+    SpikesFormat spikesFormat;
+    ///nullptr in a single process run
+    const Communicator* communicator;
+    ///number of time steps done
+    size_t time;
+    std::unique_ptr<Statistics> statistics;
+    std::unique_ptr<Recorder> recorder;
+    std::unique_ptr<LatencyHistogram> latencies;
+    std::unique_ptr<MetricsServer> metrics;
+    std::unique_ptr<SpikeRing> ring;
+    std::unique_ptr<EarlyStop> earlyStop;
+    std::unique_ptr<Accuracy> accuracy;
 };
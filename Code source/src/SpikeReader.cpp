@@ -0,0 +1,103 @@
+#include "SpikeReader.h"
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SpikeReader::SpikeReader(const std::string& name) : size(0), position(0), lost(0), header(nullptr), slots(nullptr)
+{
+#ifdef __unix__
+    std::string object(name.empty() or name[0]!='/' ? "/" + name : name);
+    int descriptor(::shm_open(object.c_str(), O_RDONLY, 0));
+    if (descriptor<0) throw(INPUT_ERROR(std::string("The shared memory ") + object + " can not be opened. \n"));
+    struct stat status;
+    void* memory(MAP_FAILED);
+    if (::fstat(descriptor, &status)==0 and size_t(status.st_size)>=sizeof(SpikeRingHeader)) {
+        size = status.st_size;
+        memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    ::close(descriptor);
+    if (memory==MAP_FAILED) throw(INPUT_ERROR(std::string("The shared memory ") + object + " can not be mapped. \n"));
+    header = static_cast<const SpikeRingHeader*>(memory);
+    if (header->magic!=_SPIKE_RING_MAGIC_ or size<(sizeof(SpikeRingHeader)+63)/64*64 + header->slots*header->slotSize) {
+        ::munmap(memory, size);
+        throw(INPUT_ERROR(std::string("The shared memory ") + object + " does not hold spikes of a simulation. \n"));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    slots = static_cast<const unsigned char*>(memory) + (sizeof(SpikeRingHeader)+63)/64*64;
+    size_t published(header->published.load(std::memory_order_acquire));
+    position = published>header->slots ? published-header->slots : 0; // the oldest time step still in the ring
+#else
+    throw(INPUT_ERROR(std::string("The shared memory of the spikes needs a Unix system. \n")));
+#endif
+}
+
+SpikeReader::~SpikeReader()
+{
+#ifdef __unix__
+    if (header) ::munmap(const_cast<SpikeRingHeader*>(header), size);
+#endif
+}
+
+bool SpikeReader::next(size_t& time, std::vector<size_t>& fired)
+{
+    size_t payload(SpikeRing::payloadSize(header->numberNeurons));
+    size_t published(header->published.load(std::memory_order_acquire));
+    while (position<published) {
+        if (published-position>header->slots) { // the writer went round the ring
+            lost += published-header->slots-position;
+            position = published-header->slots;
+        }
+        const SpikeSlot* slot(reinterpret_cast<const SpikeSlot*>(slots + (position & (header->slots-1))*header->slotSize));
+        uint64_t before(slot->sequence.load(std::memory_order_acquire));
+        if (before==2*position+2) {
+            size_t step(slot->time);
+            fired.clear();
+            if (slot->bitset) {
+                const uint64_t* words(reinterpret_cast<const uint64_t*>(slot+1));
+                for (size_t w(0); w<payload/8; ++w) {
+                    if (words[w]==0) continue;
+                    for (size_t b(0); b<64; ++b) {
+                        if ((words[w] >> b) & 1) fired.push_back(64*w+b);
+                    }
+                }
+            } else {
+                const uint32_t* indices(reinterpret_cast<const uint32_t*>(slot+1));
+                size_t count(std::min<size_t>(slot->count, payload/4)); // a count torn by the writer stays in the slot
+                fired.assign(indices, indices+count);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->sequence.load(std::memory_order_relaxed)==before) {
+                time = step;
+                ++position;
+                return true;
+            }
+        }
+        ++lost; // overwritten before or while it was read
+        ++position;
+        published = header->published.load(std::memory_order_acquire);
+    }
+    return false;
+}
+
+size_t SpikeReader::available() const
+{
+    return header->published.load(std::memory_order_acquire)-position;
+}
+
+bool SpikeReader::isClosed() const
+{
+    return header->closed.load(std::memory_order_acquire)!=0;
+}
+
+size_t SpikeReader::getLost() const
+{
+    return lost;
+}
+
+size_t SpikeReader::getNumberNeurons() const
+{
+    return header->numberNeurons;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "SpikeRing.h"
+
+/*! @class SpikeReader
+
+ The SpikeReader class follows the spikes published by a simulation in shared memory (see \ref SpikeRing), for example :
+ \code
+ SpikeReader reader("/neurons");
+ std::vector<size_t> fired;
+ size_t time;
+ while (!reader.isClosed() or reader.available()>0) {
+     if (reader.next(time, fired)) analyse(time, fired);
+     else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+ }
+ \endcode
+ The shared memory is mapped read-only : the spikes are read in place and copied only once, in the vector given. A reader starts at the oldest time step still in the ring, reads them in order, and when the simulation overwrites time steps it has not read yet, it skips them and counts them (\ref getLost()).
+ It only needs this class and SpikeRing.h, and the library rt on the oldest systems.
+*/
+
+class SpikeReader
+{
+
+public:
+
+    /*! @brief Map the shared memory of a running (or finished) simulation.
+        \param name (string) : name given to the simulation (option -y).
+    */
+    SpikeReader(const std::string& name);
+
+    ~SpikeReader();
+
+    /*! @brief Read the next time step.
+        \param time (size_t&) : time step of the simulation.
+        \param fired (vector<size_t>&) : filled with the indices of the neurons which fired, in increasing order.
+        \return false if no new time step was published, the arguments are then unchanged.
+    */
+    bool next(size_t& time, std::vector<size_t>& fired);
+
+    /// number of time steps published and not read yet (some of them may be overwritten before they are read)
+    size_t available() const;
+
+    /// true once the simulation is over : no time step will be published anymore
+    bool isClosed() const;
+
+    /// number of time steps overwritten before they were read
+    size_t getLost() const;
+
+    size_t getNumberNeurons() const;
+
+private:
+    size_t size, position, lost;
+    const SpikeRingHeader* header;
+    const unsigned char* slots;
+};
@@ -0,0 +1,92 @@
+#include "SpikeRing.h"
+#include <cstring>
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+SpikeRing::SpikeRing(const std::string& name_, size_t numberNeurons, size_t slots_) : name(name_), size(0), header(nullptr), slots(nullptr)
+{
+    if (name.empty() or name[0]!='/') name = "/" + name;
+    if (name.size()<2 or name.find('/', 1)!=std::string::npos) throw(OUTPUT_ERROR(std::string("The name of the shared memory of the spikes must not be empty nor contain a slash : ") + name + " \n"));
+    size_t number(1);
+    while (number<std::max<size_t>(slots_, 1)) number *= 2;
+    size_t slotSize((sizeof(SpikeSlot)+payloadSize(numberNeurons)+63)/64*64); // the slots do not share cache lines
+    size = (sizeof(SpikeRingHeader)+63)/64*64 + number*slotSize;
+
+#ifdef __unix__
+    ::shm_unlink(name.c_str());
+    int descriptor(::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644));
+    if (descriptor<0) throw(OUTPUT_ERROR(std::string("The shared memory ") + name + " can not be created. \n"));
+    void* memory(MAP_FAILED);
+    if (::ftruncate(descriptor, size)==0) memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor); // the mapping stays valid
+    if (memory==MAP_FAILED) {
+        ::shm_unlink(name.c_str());
+        throw(OUTPUT_ERROR(std::string("The shared memory ") + name + " can not be allocated (" + std::to_string(size) + " bytes). \n"));
+    }
+    header = static_cast<SpikeRingHeader*>(memory); // the new object is filled with zeros : all the sequence numbers are 0
+    header->numberNeurons = numberNeurons;
+    header->slots = number;
+    header->slotSize = slotSize;
+    header->published.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    slots = static_cast<unsigned char*>(memory) + (sizeof(SpikeRingHeader)+63)/64*64;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = _SPIKE_RING_MAGIC_; // the readers check it last
+#else
+    throw(OUTPUT_ERROR(std::string("The shared memory of the spikes needs a Unix system. \n")));
+#endif
+}
+
+SpikeRing::~SpikeRing()
+{
+#ifdef __unix__
+    if (header) {
+        header->closed.store(1, std::memory_order_release);
+        ::munmap(header, size);
+        ::shm_unlink(name.c_str());
+    }
+#endif
+}
+
+void SpikeRing::publish(size_t time, const std::vector<size_t>& fired)
+{
+    uint64_t number(header->published.load(std::memory_order_relaxed));
+    SpikeSlot* slot(reinterpret_cast<SpikeSlot*>(slots + (number & (header->slots-1))*header->slotSize));
+    slot->sequence.store(2*number+1, std::memory_order_relaxed); // odd : the slot is being written
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t payload(payloadSize(header->numberNeurons));
+    slot->time = time;
+    slot->count = fired.size();
+    if (4*fired.size()<=payload) {
+        slot->bitset = 0;
+        uint32_t* indices(reinterpret_cast<uint32_t*>(slot+1));
+        for (size_t i(0); i<fired.size(); ++i) indices[i] = fired[i];
+    } else {
+        slot->bitset = 1;
+        uint64_t* words(reinterpret_cast<uint64_t*>(slot+1));
+        std::memset(words, 0, payload);
+        for (auto i : fired) words[i/64] |= uint64_t(1) << (i%64);
+    }
+
+    slot->sequence.store(2*number+2, std::memory_order_release);
+    header->published.store(number+1, std::memory_order_release);
+}
+
+size_t SpikeRing::getPublished() const
+{
+    return header->published.load(std::memory_order_relaxed);
+}
+
+size_t SpikeRing::getSize() const
+{
+    return size;
+}
+
+size_t SpikeRing::payloadSize(size_t numberNeurons)
+{
+    return std::max<size_t>(1, (numberNeurons+63)/64)*8;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Network.h"
+#include <atomic>
+
+/*! @class SpikeRing
+
+ The SpikeRing class publishes the spikes of each time step in a ring of slots in POSIX shared memory, so that analysis or visualization processes running on the same machine can follow a simulation live, without the files and without slowing it down (the reading side is the class \ref SpikeReader).
+
+ The shared memory object (/dev/shm/name on Linux) begins with a \ref SpikeRingHeader, followed by a power of two number of slots of the same size, aligned on cache lines. A slot holds one time step : a \ref SpikeSlot header then the spikes, as the list of the indices (4 bytes each) when few neurons fired, or as a bitset of all the neurons (one bit each) when the list would be larger, so that the size of a slot only depends on the number of neurons.
+ There is one writer and any number of readers, which never write in the shared memory : the simulation never waits for them. Each slot is protected by its sequence number (a seqlock) : it is odd while the slot is written, and it is 2*(n+1) once the time step number n (counted from 0) is complete. A reader which is late by more than the number of slots loses the oldest time steps, it detects it and counts them.
+ The shared memory only exists on Unix systems : elsewhere, the constructor throws an OUTPUT_ERROR.
+*/
+
+///first word of the shared memory of a SpikeRing
+#define _SPIKE_RING_MAGIC_ 0x4e52535052494e47ULL
+
+///beginning of the shared memory
+struct SpikeRingHeader
+{
+    uint64_t magic;
+    uint64_t numberNeurons;
+    ///number of slots (a power of two) and size of a slot in bytes, header included
+    uint64_t slots, slotSize;
+    ///number of time steps published, and 1 once the simulation is over
+    std::atomic<uint64_t> published, closed;
+};
+
+///beginning of a slot
+struct SpikeSlot
+{
+    std::atomic<uint64_t> sequence;
+    ///time step of the simulation and number of spikes
+    uint64_t time, count;
+    ///1 if the spikes are stored as a bitset, 0 if they are a list of indices
+    uint64_t bitset;
+};
+
+class SpikeRing
+{
+
+public:
+
+    /*! @brief Create the shared memory (an existing object of the same name is replaced).
+        \param name_ (string) : name of the shared memory object, as for shm_open ("/name").
+        \param numberNeurons (size_t) : number of neurons of the network.
+        \param slots (size_t) : number of time steps kept in the ring, rounded up to a power of two.
+    */
+    SpikeRing(const std::string& name_, size_t numberNeurons, size_t slots=_SPIKE_RING_SLOTS_);
+
+    /// mark the ring as closed for the readers, and remove its name (the readers keep their mapping)
+    ~SpikeRing();
+
+    /*! @brief Write the spikes of a time step in the next slot.
+        \param time (size_t) : current time step.
+        \param fired (vector<size_t>) : indices of the neurons which fired.
+    */
+    void publish(size_t time, const std::vector<size_t>& fired);
+
+    /// number of time steps published
+    size_t getPublished() const;
+
+    /// size of the shared memory in bytes
+    size_t getSize() const;
+
+    /// size in bytes of the spikes in a slot : the bitset of the neurons, which also holds a list of a quarter of this size
+    static size_t payloadSize(size_t numberNeurons);
+
+private:
+    std::string name;
+    size_t size;
+    SpikeRingHeader* header;
+    unsigned char* slots;
+};
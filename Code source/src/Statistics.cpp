@@ -0,0 +1,148 @@
+#include "Statistics.h"
+
+Statistics::Statistics(const Network& network, size_t window_) : window(window_), steps(0), spikeCounts(network.getNumberNeurons(), 0), lastSpike(network.getNumberNeurons(), 0), sumActivity(0.0), sumActivity2(0.0), sumWindow(0.0), sumWindow2(0.0), windows(0)
+{
+    if (window==0) throw std::invalid_argument("The window of the statistics must last at least one time step.");
+
+    for (const auto& proportion : network.getNeuronsProportions()) {
+        types.push_back(proportion.first);
+        typeSizes.push_back(proportion.second);
+    }
+    const Neurons& neurons(network.getNeurons());
+    typeOf.resize(neurons.size());
+    for (size_t i(0); i<neurons.size(); ++i) {
+        for (size_t t(0); t<types.size(); ++t) {
+            if (neurons[i]->isType(types[t])) typeOf[i] = t;
+        }
+    }
+    intervals.assign(types.size(), std::vector<size_t>(_ISI_BINS_+1, 0));
+    windowSpikes.assign(types.size(), 0);
+    typeSpikes.assign(types.size(), 0);
+    typeWindow.assign(types.size(), 0.0);
+    typeWindow2.assign(types.size(), 0.0);
+}
+
+void Statistics::record(const std::vector<size_t>& fired, size_t time)
+{
+    ++steps;
+    for (auto i : fired) {
+        ++spikeCounts[i];
+        ++windowSpikes[typeOf[i]];
+        ++typeSpikes[typeOf[i]];
+        if (lastSpike[i]>0) ++intervals[typeOf[i]][std::min<size_t>(time-lastSpike[i], _ISI_BINS_+1)-1];
+        lastSpike[i] = time;
+    }
+
+    double activity(double(fired.size())/spikeCounts.size());
+    sumActivity += activity;
+    sumActivity2 += activity*activity;
+
+    if (time%window==0) {
+        std::vector<double> rate(types.size());
+        double total(0.0);
+        for (size_t t(0); t<types.size(); ++t) {
+            rate[t] = typeSizes[t] ? 1000.0*windowSpikes[t]/(double(typeSizes[t])*window) : 0.0;
+            total += windowSpikes[t];
+            typeWindow[t] += windowSpikes[t];
+            typeWindow2[t] += double(windowSpikes[t])*windowSpikes[t];
+            windowSpikes[t] = 0;
+        }
+        rates.push_back(rate);
+        sumWindow += total;
+        sumWindow2 += total*total;
+        ++windows;
+    }
+}
+
+double Statistics::getSynchrony() const
+{
+    if (steps==0) return 0.0;
+    double mean(sumActivity/steps);
+    double variance(sumActivity2/steps - mean*mean);
+    double neuronVariance(0.0); // a spike train is a sequence of 0 and 1 : its variance is p(1-p)
+    for (auto count : spikeCounts) {
+        double p(double(count)/steps);
+        neuronVariance += p*(1.0-p);
+    }
+    neuronVariance /= spikeCounts.size();
+    return neuronVariance>0.0 ? std::sqrt(std::max(variance, 0.0)/neuronVariance) : 0.0;
+}
+
+double Statistics::getFanoFactor() const
+{
+    if (windows==0 or sumWindow==0.0) return 0.0;
+    double mean(sumWindow/windows);
+    return (sumWindow2/windows - mean*mean)/mean;
+}
+
+size_t Statistics::getTypeSpikes(size_t type) const
+{
+    return typeSpikes[type];
+}
+
+double Statistics::getRate(size_t type) const
+{
+    return (steps and typeSizes[type]) ? 1000.0*typeSpikes[type]/(double(typeSizes[type])*steps) : 0.0;
+}
+
+double Statistics::getFanoFactor(size_t type) const
+{
+    if (windows==0 or typeWindow[type]==0.0) return 0.0;
+    double mean(typeWindow[type]/windows);
+    return (typeWindow2[type]/windows - mean*mean)/mean;
+}
+
+void Statistics::print(std::ostream& outfile) const
+{
+    outfile << "# population firing rate (Hz) of each type, on windows of " << window << " time steps" << std::endl;
+    outfile << "time";
+    for (const auto& type : types) outfile << "\t" << type;
+    outfile << "\n";
+    for (size_t w(0); w<rates.size(); ++w) {
+        outfile << (w+1)*window;
+        for (auto rate : rates[w]) outfile << "\t" << rate;
+        outfile << "\n";
+    }
+
+    outfile << "# inter-spike intervals histogram (number of intervals of each duration in ms, the last line counts the longer intervals)" << std::endl;
+    outfile << "interval";
+    for (const auto& type : types) outfile << "\t" << type;
+    outfile << "\n";
+    for (size_t b(0); b<=_ISI_BINS_; ++b) {
+        if (b<_ISI_BINS_) outfile << b+1;
+        else outfile << ">" << _ISI_BINS_;
+        for (const auto& histogram : intervals) outfile << "\t" << histogram[b];
+        outfile << "\n";
+    }
+
+    outfile << "# synchrony" << std::endl;
+    outfile << "chi\t" << getSynchrony() << "\n";
+    outfile << "fano\t" << getFanoFactor() << "\n";
+
+    outfile << "# number of spikes and firing rate (Hz) of each neuron" << std::endl;
+    outfile << "neuron\ttype\tspikes\trate\n";
+    for (size_t i(0); i<spikeCounts.size(); ++i) {
+        outfile << i << "\t" << types[typeOf[i]] << "\t" << spikeCounts[i] << "\t" << (steps ? 1000.0*spikeCounts[i]/steps : 0.0) << "\n";
+    }
+    outfile.flush();
+}
+
+const std::vector<size_t>& Statistics::getSpikeCounts() const
+{
+    return spikeCounts;
+}
+
+const std::vector<std::vector<double> >& Statistics::getRates() const
+{
+    return rates;
+}
+
+const std::vector<size_t>& Statistics::getIntervals(size_t type) const
+{
+    return intervals[type];
+}
+
+const std::vector<std::string>& Statistics::getTypes() const
+{
+    return types;
+}
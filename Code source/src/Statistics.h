@@ -0,0 +1,75 @@
+#pragma once
+#include "Network.h"
+
+/*! @class Statistics
+
+ The Statistics class computes, during the simulation, a summary of the activity of a \ref Network, so that the spikes of every neuron do not need to be written and post-processed :
+ - the population firing rate of each neuron type (see \ref Network::getNeuronsProportions()) on consecutive windows of time steps,
+ - the number of spikes of each neuron,
+ - the histogram of the inter-spike intervals of each neuron type,
+ - two synchrony measures : the synchrony coefficient \b chi (Golomb, 2007), which is the standard deviation of the population activity divided by the mean standard deviation of the single neurons (0 for independent neurons, 1 for perfectly synchronous ones), and the Fano factor of the number of spikes of the population in each window.
+
+ Everything is updated incrementally from the indices of the neurons which fired (\ref Network::getFired()), so a time step only costs a few operations per spike.
+*/
+
+class Statistics
+{
+
+public:
+
+    /*! @brief Find the type of each neuron once for all.
+        \param network (Network&) : the network to study.
+        \param window_ (size_t) : number of time steps of a window for the population rates.
+    */
+    Statistics(const Network& network, size_t window_);
+
+    /*! @brief Record the spikes of one time step.
+        \param fired (vector<size_t>) : indices of the neurons which fired.
+        \param time (size_t) : current time step (the windows end at the multiples of the window size).
+    */
+    void record(const std::vector<size_t>& fired, size_t time);
+
+    /*! @brief Writes the summary : population rates per window, inter-spike interval histograms, synchrony measures and spike count of each neuron.
+        \param outfile (ostream&) : the output file (suffix _statistics).
+    */
+    void print(std::ostream& outfile) const;
+
+    /*!
+       @name Utility methods (getters)
+       Rates are in Hz (a time step lasts 1 ms).
+       *getTypeSpikes()*, *getRate()* and *getFanoFactor()* with a type give the number of spikes of the neurons of this type, their mean rate since the first time step and the Fano factor of their number of spikes in each window.
+    */
+///@{
+    const std::vector<size_t>& getSpikeCounts() const;
+    const std::vector<std::vector<double> >& getRates() const;
+    const std::vector<size_t>& getIntervals(size_t type) const;
+    const std::vector<std::string>& getTypes() const;
+    double getSynchrony() const;
+    double getFanoFactor() const;
+    size_t getTypeSpikes(size_t type) const;
+    double getRate(size_t type) const;
+    double getFanoFactor(size_t type) const;
+///@}
+
+private:
+    size_t window, steps;
+    std::vector<std::string> types;
+    ///number of neurons of each type
+    std::vector<size_t> typeSizes;
+    ///type (index in types) of each neuron
+    std::vector<size_t> typeOf;
+    std::vector<size_t> spikeCounts;
+    ///time of the last spike of each neuron (0 : no spike yet)
+    std::vector<size_t> lastSpike;
+    ///histogram of the inter-spike intervals of each type, the last bin counts the intervals longer than _ISI_BINS_
+    std::vector<std::vector<size_t> > intervals;
+    ///spikes of each type in the current window, and rate of each type in each finished window
+    std::vector<size_t> windowSpikes;
+    std::vector<std::vector<double> > rates;
+    ///sums used by the synchrony measures
+    double sumActivity, sumActivity2, sumWindow, sumWindow2;
+    ///spikes of each type since the first time step, and sums of the spikes of each type in each window and of their squares
+    std::vector<size_t> typeSpikes;
+    std::vector<double> typeWindow, typeWindow2;
+    size_t windows;
+};
@@ -0,0 +1,150 @@
+#include "Stimuli.h"
+#include "Network.h"
+
+Stimuli::Stimuli(const RandomNumbers& generator_) : generator(generator_) {}
+
+void Stimuli::addStep(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude)
+{
+    Stimulus stimulus{STEP, targets, start, end, amplitude, 0, 0, 0.0, 0.0, 0.0, nullptr, {}, 0, 0};
+    add(stimulus);
+}
+
+void Stimuli::addPulses(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, size_t period, size_t width)
+{
+    if (period==0) throw std::invalid_argument("The period of the pulses must last at least one time step.");
+    Stimulus stimulus{PULSES, targets, start, end, amplitude, period, width, 0.0, 0.0, 0.0, nullptr, {}, 0, 0};
+    add(stimulus);
+}
+
+void Stimuli::addSinusoid(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, double frequency, double phase, double offset)
+{
+    Stimulus stimulus{SINUSOID, targets, start, end, amplitude, 0, 0, 2.0*M_PI*frequency*_DT_/1000.0, phase, offset, nullptr, {}, 0, 0};
+    add(stimulus);
+}
+
+void Stimuli::addPoisson(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, double rate)
+{
+    if (rate<0.0 or rate*_DT_>1000.0) throw std::invalid_argument("The rate of a Poisson spike train must be between 0 and 1000 Hz (at most one spike per time step).");
+    Stimulus stimulus{POISSON, targets, start, end, amplitude, 0, 0, rate*_DT_/1000.0, 0.0, 0.0, nullptr, {}, 0, 0};
+    add(stimulus);
+}
+
+void Stimuli::addRecording(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, const std::string& fileName)
+{
+    std::unique_ptr<std::ifstream> recording(new std::ifstream(fileName, std::ios_base::in | std::ios_base::binary));
+    if (!recording->good()) throw(INPUT_ERROR(std::string("The recording " + fileName + " of a stimulus can not be read. \n")));
+    Stimulus stimulus{RECORDING, targets, start, end, amplitude, 0, 0, 0.0, 0.0, 0.0, std::move(recording), {}, 0, 0};
+    add(stimulus);
+}
+
+void Stimuli::add(Stimulus& stimulus)
+{
+    if (stimulus.targets.empty()) throw std::invalid_argument("A stimulus must have at least one target.");
+    if (stimulus.start==0) throw std::invalid_argument("A stimulus can not start before the first time step (1).");
+    if (stimulus.end>0 and stimulus.end<stimulus.start) throw std::invalid_argument("A stimulus can not end before it starts.");
+    stimuli.push_back(std::move(stimulus));
+}
+
+void Stimuli::load(const std::string& fileName, const Network& network)
+{
+    std::ifstream config(fileName);
+    if (!config.good()) throw(INPUT_ERROR(std::string("The stimuli file " + fileName + " can not be read. \n")));
+
+    std::string line;
+    for (size_t number(1); std::getline(config, line); ++number) {
+        std::istringstream fields(line);
+        std::string kind, targets;
+        if (!(fields >> kind) or kind[0]=='#') continue; // empty line or comment
+        size_t start, end;
+        double amplitude;
+        if (!StimulusKinds.count(kind) or !(fields >> targets >> start >> end >> amplitude)) throw std::invalid_argument("The line " + std::to_string(number) + " of the stimuli file " + fileName + " is not valid (kind targets start end amplitude, then the parameters of the kind).");
+        std::vector<size_t> indices(network.selectNeurons(targets));
+
+        bool valid(true);
+        switch (StimulusKinds.at(kind)) {
+        case STEP :
+            addStep(indices, start, end, amplitude);
+            break;
+        case PULSES : {
+            size_t period, width;
+            valid = bool(fields >> period >> width);
+            if (valid) addPulses(indices, start, end, amplitude, period, width);
+            break;
+        }
+        case SINUSOID : {
+            double frequency, phase(0.0), offset(0.0);
+            valid = bool(fields >> frequency);
+            if (fields >> phase) fields >> offset;
+            if (valid) addSinusoid(indices, start, end, amplitude, frequency, phase, offset);
+            break;
+        }
+        case POISSON : {
+            double rate;
+            valid = bool(fields >> rate);
+            if (valid) addPoisson(indices, start, end, amplitude, rate);
+            break;
+        }
+        case RECORDING : {
+            std::string recording;
+            valid = bool(fields >> recording);
+            if (valid) addRecording(indices, start, end, amplitude, recording);
+            break;
+        }
+        }
+        if (!valid) throw std::invalid_argument("The parameters of the " + kind + " stimulus at the line " + std::to_string(number) + " of the stimuli file " + fileName + " are missing.");
+    }
+}
+
+void Stimuli::apply(size_t time, std::vector<double>& current)
+{
+    std::fill(current.begin(), current.end(), 0.0);
+    for (auto& stimulus : stimuli) {
+        if (time<stimulus.start or (stimulus.end>0 and time>stimulus.end)) continue;
+
+        double value(stimulus.amplitude);
+        switch (stimulus.kind) {
+        case STEP :
+            break;
+        case PULSES :
+            if ((time-stimulus.start)%stimulus.period>=stimulus.width) continue;
+            break;
+        case SINUSOID :
+            value = stimulus.offset + stimulus.amplitude*std::sin(stimulus.frequency*time + stimulus.phase);
+            break;
+        case POISSON :
+            for (auto target : stimulus.targets) {
+                if (generator.uniform_double(0.0, 1.0)<stimulus.frequency) current[target] += stimulus.amplitude;
+            }
+            continue;
+        case RECORDING : {
+            if (!stimulus.recording) continue; // the recording ended
+            if (stimulus.position==stimulus.steps and !readRecording(stimulus)) continue;
+            const double* values(&stimulus.buffer[stimulus.position*stimulus.targets.size()]);
+            for (size_t k(0); k<stimulus.targets.size(); ++k) current[stimulus.targets[k]] += stimulus.amplitude*values[k];
+            ++stimulus.position;
+            continue;
+        }
+        }
+        for (auto target : stimulus.targets) current[target] += value;
+    }
+}
+
+bool Stimuli::readRecording(Stimulus& stimulus)
+{
+    size_t frame(stimulus.targets.size()*sizeof(double));
+    stimulus.buffer.resize(_STIMULUS_BUFFER_STEPS_*stimulus.targets.size());
+    stimulus.recording->read(reinterpret_cast<char*>(stimulus.buffer.data()), _STIMULUS_BUFFER_STEPS_*frame);
+    stimulus.steps = stimulus.recording->gcount()/frame; // an incomplete time step at the end of the file is ignored
+    stimulus.position = 0;
+    if (stimulus.steps==0) {
+        stimulus.recording.reset();
+        std::vector<double>().swap(stimulus.buffer);
+        return false;
+    }
+    return true;
+}
+
+size_t Stimuli::getNumberStimuli() const
+{
+    return stimuli.size();
+}
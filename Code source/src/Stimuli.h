@@ -0,0 +1,98 @@
+#pragma once
+#include "constants.h"
+#include "Random.h"
+#include <memory>
+
+class Network;
+
+/*! @class Stimuli
+
+ The Stimuli class gathers the external currents injected in sets of neurons (the targets) during the simulation, in addition to the noise and to the synaptic current of \ref Neurone::computeI(). A stimulus is active from its start to its end time step (included, 0 : until the end of the simulation) and is one of the \ref StimulusKind :
+ - a step : a constant current \b amplitude,
+ - pulses : a current \b amplitude during the first \b width time steps of each \b period,
+ - a sinusoid : \b offset + \b amplitude * sin(2 pi \b frequency t + \b phase), the frequency being in Hz (a time step lasts 1 ms),
+ - a Poisson spike train : at each time step, the current \b amplitude is injected with a probability \b rate (in Hz) * 1 ms, independently for each target,
+ - a recording : binary file of doubles (native byte order), with one value for each target at each time step, multiplied by \b amplitude. The file is read by blocks of \ref _STIMULUS_BUFFER_STEPS_ time steps while the simulation runs, so a recording of several hours only needs a small buffer; it can also be a named pipe written by another program. The stimulus ends with the file.
+
+ The stimuli can be added with the *add...()* methods or read from a configuration file (see *load()*).
+ At each time step, *apply()* adds the current of every active stimulus in an array holding the input current of each neuron, which the \ref Network adds to the current of its neurons (see \ref Network::update()).
+ The Poisson spike trains use a random generator of their own (a different stream of the seed of the simulation), so that the random sequence of the network (and the distributed mode) is not modified.
+*/
+
+class Stimuli
+{
+
+public:
+
+    /*! @brief \param generator_ (RandomNumbers) : random generator of the Poisson spike trains (by default, the stream of the stimuli of the default seed, see \ref Network::Network()).
+    */
+    Stimuli(const RandomNumbers& generator_=RandomNumbers(_SEED_, 1));
+
+    /*! @name Add a stimulus
+        \param targets (vector<size_t>) : indices of the neurons which receive the stimulus (see \ref Network::selectNeurons()).
+        \param start (size_t) : first time step of the stimulus.
+        \param end (size_t) : last time step of the stimulus (0 : until the end of the simulation).
+        \param amplitude (double) : amplitude of the current (for a recording, factor applied to the recorded values).
+        \param period, width (size_t) : period and duration of the pulses, in time steps.
+        \param frequency (double) : frequency of the sinusoid, in Hz.
+        \param phase (double) : phase of the sinusoid at t=0, in radians.
+        \param offset (double) : constant current added to the sinusoid.
+        \param rate (double) : rate of the Poisson spike train, in Hz.
+        \param fileName (string) : binary file of the recording.
+    */
+///@{
+    void addStep(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude);
+    void addPulses(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, size_t period, size_t width);
+    void addSinusoid(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, double frequency, double phase=0.0, double offset=0.0);
+    void addPoisson(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, double rate);
+    void addRecording(const std::vector<size_t>& targets, size_t start, size_t end, double amplitude, const std::string& fileName);
+///@}
+
+    /*! @brief Read the stimuli of a configuration file : one stimulus per line, the lines starting with # are ignored. A line gives the kind of the stimulus (step, pulse, sine, poisson or file), its targets (see \ref Network::selectNeurons()), start, end and amplitude, then the parameters of its kind :
+        \verbatim
+        step    RS:10      100 200 5
+        pulse   0,1,2      1   0   10 50 5
+        sine    random:20  1   0   3  10 0 2
+        poisson FS:5       1   0   20 40
+        file    all        1   0   1  input.bin
+        \endverbatim
+        \param fileName (string) : name of the configuration file.
+        \param network (Network&) : the network whose neurons are stimulated.
+    */
+    void load(const std::string& fileName, const Network& network);
+
+    /*! @brief Add the current of the active stimuli at a given time step.
+        \param time (size_t) : the time step (the first one is 1).
+        \param current (vector<double>&) : input current of each neuron of the network, set to 0 then increased by each stimulus.
+    */
+    void apply(size_t time, std::vector<double>& current);
+
+    /*!
+       @name Utility methods (getters)
+    */
+///@{
+    size_t getNumberStimuli() const;
+///@}
+
+private:
+    struct Stimulus {
+        StimulusKind kind;
+        std::vector<size_t> targets;
+        size_t start, end;
+        double amplitude;
+        ///period and width of the pulses
+        size_t period, width;
+        ///frequency (in rad per time step), phase and offset of the sinusoid, or probability of a spike at each time step
+        double frequency, phase, offset;
+        ///recorded values of the next time steps and position of the next time step in it
+        std::unique_ptr<std::ifstream> recording;
+        std::vector<double> buffer;
+        size_t position, steps;
+    };
+    void add(Stimulus& stimulus);
+    /// read the next time steps of a recording, false if the file ended
+    bool readRecording(Stimulus& stimulus);
+
+    std::vector<Stimulus> stimuli;
+    RandomNumbers generator;
+};
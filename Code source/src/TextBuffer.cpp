@@ -0,0 +1,97 @@
+#include "TextBuffer.h"
+#include <cstdio>
+#include <cstring>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+TextBuffer::TextBuffer(size_t capacity_) : buffer(capacity_+64), used(0), capacity(capacity_) {}
+
+char* TextBuffer::reserve(size_t bytes)
+{
+    if (used+bytes>buffer.size()) buffer.resize(std::max(2*buffer.size(), used+bytes));
+    return buffer.data()+used;
+}
+
+TextBuffer& TextBuffer::operator<<(char character)
+{
+    *reserve(1) = character;
+    ++used;
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(const char* text)
+{
+    size_t length(std::strlen(text));
+    std::memcpy(reserve(length), text, length);
+    used += length;
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(const std::string& text)
+{
+    std::memcpy(reserve(text.size()), text.data(), text.size());
+    used += text.size();
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(bool value)
+{
+    *reserve(1) = value ? '1' : '0';
+    ++used;
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(size_t value)
+{
+    char digits[20]; // the digits are found from the last one
+    size_t number(0);
+    do {
+        digits[number++] = '0'+value%10;
+        value /= 10;
+    } while (value>0);
+    char* text(reserve(number));
+    for (size_t k(0); k<number; ++k) text[k] = digits[number-1-k];
+    used += number;
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(double value)
+{
+    char* text(reserve(32));
+#if __cplusplus >= 201703L and defined(__cpp_lib_to_chars)
+    used = std::to_chars(text, text+32, value, std::chars_format::general, 6).ptr-buffer.data();
+#else
+    used += std::snprintf(text, 32, "%g", value);
+#endif
+    return *this;
+}
+
+void TextBuffer::write(std::ostream& outfile)
+{
+    outfile.write(buffer.data(), used);
+    used = 0;
+}
+
+void TextBuffer::swap(std::vector<char>& text)
+{
+    buffer.swap(text);
+    text.resize(used);
+    buffer.resize(std::max(buffer.size(), capacity+64)); // no allocation if the memory given back was already used by a buffer
+    used = 0;
+}
+
+size_t TextBuffer::size() const
+{
+    return used;
+}
+
+bool TextBuffer::isFull() const
+{
+    return used>=capacity;
+}
+
+std::string TextBuffer::str() const
+{
+    return std::string(buffer.data(), used);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "constants.h"
+
+/*! @class TextBuffer
+
+ The TextBuffer class formats the text of the output files in a large buffer, which is written at once in its file (see *write()*), instead of formatting each value with the operator << of a std::ostream.
+
+ The text is exactly the one a std::ostream with the default format would give : the integers are written in decimal, the booleans as 0 or 1 and the doubles with 6 significant digits (the format %g of printf). The integers are formatted by a loop on their digits, the doubles by std::to_chars when the library has it (C++17) and snprintf otherwise, both without the locale and the state of a std::ostream.
+
+ The \ref Simulation keeps one TextBuffer for the spikes and one for the neurons sample, which are written in their files each time they hold \ref _TEXT_BUFFER_SIZE_ bytes, so the output files are written with a few large writes. In a paced simulation, the full buffers are handed to the thread which writes the files (see \ref AsyncOutput).
+*/
+
+class TextBuffer
+{
+
+public:
+
+    /*! @brief \param capacity_ (size_t) : number of bytes allocated once (the buffer grows if more text is added before it is written).
+    */
+    TextBuffer(size_t capacity_=_TEXT_BUFFER_SIZE_);
+
+    /*! @name Add a value at the end of the text
+    */
+///@{
+    TextBuffer& operator<<(char character);
+    TextBuffer& operator<<(const char* text);
+    TextBuffer& operator<<(const std::string& text);
+    TextBuffer& operator<<(bool value);
+    TextBuffer& operator<<(size_t value);
+    TextBuffer& operator<<(double value);
+///@}
+
+    /*! @brief Write the text in an output file and empty the buffer.
+        \param outfile (ostream&) : the output file (a std::ofstream, an \ref AsyncOutput or a \ref CompressedOutput).
+    */
+    void write(std::ostream& outfile);
+
+    /*! @brief Exchange the text with the memory of another vector and empty the buffer, so that the text can be written later without being copied (see \ref AsyncOutput).
+        \param text (vector<char>&) : the memory given to the buffer (its content is discarded), it receives the text.
+    */
+    void swap(std::vector<char>& text);
+
+    /*!
+       @name Utility methods (getters)
+       *isFull()* tells if the text has reached the capacity of the buffer, and should be written.
+    */
+///@{
+    size_t size() const;
+    bool isFull() const;
+    std::string str() const;
+///@}
+
+private:
+    /// make room for at least bytes more characters
+    char* reserve(size_t bytes);
+
+    std::vector<char> buffer;
+    size_t used, capacity;
+};
@@ -0,0 +1,138 @@
+#include "Topology.h"
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+Topology::Topology(char model, size_t numberNeurons, double meanConnectivity, double rewiring, RandomNumbers& generator) : offsets(numberNeurons+1, 0)
+{
+    if (numberNeurons>=(uint64_t(1) << 32)) throw std::invalid_argument("The structured networks can not have more than 2^32 - 1 neurons.");
+    if (rewiring<0.0 or rewiring>1.0) throw std::invalid_argument("The rewiring probability must be between 0 and 1.");
+    if (model=='W') drawSmallWorld(numberNeurons, meanConnectivity, rewiring, generator);
+    else if (model=='A') drawScaleFree(numberNeurons, meanConnectivity, generator);
+    else throw std::invalid_argument(std::string("The model ") + model + " is not a structured network.");
+}
+
+bool Topology::isStructured(char model)
+{
+    return model=='W' or model=='A';
+}
+
+void Topology::drawSmallWorld(size_t numberNeurons, double meanConnectivity, double rewiring, RandomNumbers& generator)
+{
+    size_t n(numberNeurons);
+    if (n<2) return;
+    size_t k(std::min<size_t>(std::max(0.0, std::round(meanConnectivity)), n-1));
+    std::vector<size_t> ring(n); // neuron at each place of the ring
+    std::iota(ring.begin(), ring.end(), 0);
+    generator.shuffle(ring);
+
+    for (size_t i(0); i<=n; ++i) offsets[i] = i*k;
+    sources.resize(n*k);
+    std::vector<uint8_t> linked(n, 0);
+    for (size_t place(0); place<n; ++place) {
+        size_t neuron(ring[place]);
+        uint32_t* links(&sources[offsets[neuron]]);
+        for (size_t j(0); j<k; ++j) { // the nearest neighbours, alternately after and before the neuron
+            size_t distance(j/2+1);
+            links[j] = ring[j%2==0 ? (place+distance)%n : (place+n-distance)%n];
+            linked[links[j]] = 1;
+        }
+        linked[neuron] = 1;
+        if (k+1<n) { // a complete network can not be rewired
+            for (size_t j(0); j<k; ++j) {
+                if (generator.uniform_double()>=rewiring) continue;
+                size_t source;
+                do source = generator.uniform_int(0, n-1); while (linked[source]);
+                linked[source] = 1;
+                linked[links[j]] = 0;
+                links[j] = source;
+            }
+        }
+        for (size_t j(0); j<k; ++j) linked[links[j]] = 0;
+        linked[neuron] = 0;
+    }
+    transpose(); // the links of each source, sorted by target
+    transpose(); // the links of each target, sorted by source
+}
+
+void Topology::drawScaleFree(size_t numberNeurons, double meanConnectivity, RandomNumbers& generator)
+{
+    size_t n(numberNeurons);
+    if (n<2) return;
+    size_t m(std::min<size_t>(std::max(1.0, std::round(0.5*meanConnectivity)), n-1)), first(m+1);
+    std::vector<size_t> arrival(n); // neuron arrived at each rank
+    std::iota(arrival.begin(), arrival.end(), 0);
+    generator.shuffle(arrival);
+
+    std::vector<uint32_t> ends; // the two ends of each link drawn : a neuron appears once per link
+    ends.reserve(2*(first*(first-1)/2 + (n-first)*m));
+    for (size_t a(0); a<first; ++a) {
+        for (size_t b(0); b<a; ++b) {
+            ends.push_back(arrival[a]);
+            ends.push_back(arrival[b]);
+        }
+    }
+    std::vector<uint8_t> chosen(n, 0);
+    std::vector<uint32_t> targets;
+    for (size_t a(first); a<n; ++a) {
+        size_t drawn(ends.size()); // the links of the new neuron are not drawn from
+        targets.clear();
+        while (targets.size()<m) {
+            uint32_t target(ends[generator.uniform_int(0, drawn-1)]); // probability proportional to the degree
+            if (chosen[target]) continue;
+            chosen[target] = 1;
+            targets.push_back(target);
+        }
+        for (auto target : targets) {
+            chosen[target] = 0;
+            ends.push_back(arrival[a]);
+            ends.push_back(target);
+        }
+    }
+
+    for (auto end : ends) ++offsets[end+1]; // each link is received by both ends
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    sources.resize(ends.size());
+    std::vector<uint64_t> next(offsets.begin(), offsets.end()-1);
+    for (size_t e(0); e<ends.size(); e+=2) {
+        sources[next[ends[e]]++] = ends[e+1];
+        sources[next[ends[e+1]]++] = ends[e];
+    }
+    std::vector<uint32_t>().swap(ends);
+    transpose(); // the matrix is symmetric : its transpose has the same links, sorted
+}
+
+void Topology::transpose()
+{
+    size_t n(offsets.size()-1);
+    std::vector<uint64_t> transposed(n+1, 0);
+    for (auto source : sources) ++transposed[source+1];
+    std::partial_sum(transposed.begin(), transposed.end(), transposed.begin());
+    std::vector<uint32_t> rows(sources.size());
+    std::vector<uint64_t> next(transposed.begin(), transposed.end()-1);
+    for (size_t i(0); i<n; ++i) { // the rows are read in increasing order, so each new row is sorted
+        for (uint64_t l(offsets[i]); l<offsets[i+1]; ++l) rows[next[sources[l]]++] = i;
+    }
+    offsets.swap(transposed);
+    sources.swap(rows);
+}
+
+size_t Topology::getNumberNeurons() const
+{
+    return offsets.size()-1;
+}
+
+size_t Topology::getNumberLinks() const
+{
+    return sources.size();
+}
+
+size_t Topology::getDegree(size_t neuron) const
+{
+    return offsets[neuron+1]-offsets[neuron];
+}
+
+const uint32_t* Topology::getSources(size_t neuron) const
+{
+    return sources.data()+offsets[neuron];
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Random.h"
+#include <cstdint>
+
+/*! @class Topology
+
+ The Topology class draws the links of the structured network models, in a time proportional to the number of links :
+ - 'W' : a small-world network (Watts-Strogatz). The neurons are placed on a ring in a random order (so that the types are mixed), each neuron receives links from its k = mean connectivity nearest neighbours on the ring, then each link is rewired with the rewiring probability to a source drawn uniformly among the neurons which are not linked to it yet.
+ - 'A' : a scale-free network (Barabasi-Albert). The neurons arrive in a random order, the first m+1 ones are all linked together, then each neuron is linked to m distinct neurons already arrived, chosen with a probability proportional to their number of links (m = half the mean connectivity). A link goes in both directions, so the number of links received by a neuron is its degree, with a mean close to the mean connectivity and a power law tail.
+ The probability proportional to the degree is drawn in constant time from the array of the ends of all the links drawn (a neuron appears in it once per link), instead of a scan of the cumulative degrees, which would be quadratic.
+
+ The sources of the links received by each neuron are stored as in a compressed sparse row matrix (4 bytes per link, sorted by source), read by \ref Network to create its links. The sorting is done by transposing the matrix, in linear time too.
+*/
+
+class Topology
+{
+
+public:
+
+    /*! @brief Draw the links.
+        \param model (char) : 'W' (small-world) or 'A' (scale-free), throws std::invalid_argument for any other model.
+        \param numberNeurons (size_t) : number of neurons, less than 2^32.
+        \param meanConnectivity (double) : mean number of links received by a neuron (at most the number of neurons - 1).
+        \param rewiring (double) : rewiring probability of the small-world links, between 0 (ring lattice) and 1 (random network).
+        \param generator (RandomNumbers&) : random generator of the network.
+    */
+    Topology(char model, size_t numberNeurons, double meanConnectivity, double rewiring, RandomNumbers& generator);
+
+    /// true for the models drawn by this class
+    static bool isStructured(char model);
+
+    /*!@name Utility methods (getters)
+    */
+///@{
+    size_t getNumberNeurons() const;
+    size_t getNumberLinks() const;
+    /// number of links received by a neuron
+    size_t getDegree(size_t neuron) const;
+    /// sources of the links received by a neuron, in increasing order (getDegree() values)
+    const uint32_t* getSources(size_t neuron) const;
+///@}
+
+private:
+    void drawSmallWorld(size_t numberNeurons, double meanConnectivity, double rewiring, RandomNumbers& generator);
+    void drawScaleFree(size_t numberNeurons, double meanConnectivity, RandomNumbers& generator);
+    /// replace the matrix by its transpose (the links of each source), whose rows are sorted
+    void transpose();
+
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> sources;
+};
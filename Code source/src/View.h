@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+
+/*! @class View
+
+ The View class gives a read-only access to contiguous values owned by another object (the neurons of a \ref Network, the links of a \ref Neurone), without copying them : it only holds a pointer and a size, like std::span in C++20. It can be iterated with a range-based for loop, and stays valid as long as the values are not reallocated (the neurons and the links of a network are never reallocated once it is built).
+*/
+
+template<class T>
+class View
+{
+
+public:
+    typedef const T* const_iterator;
+
+    View(const T* first_=nullptr, size_t size_=0) : first(first_), number(size_) {}
+
+    const T* begin() const
+    {
+        return first;
+    }
+
+    const T* end() const
+    {
+        return first+number;
+    }
+
+    size_t size() const
+    {
+        return number;
+    }
+
+    bool empty() const
+    {
+        return number==0;
+    }
+
+    const T& operator[](size_t i) const
+    {
+        return first[i];
+    }
+
+private:
+    const T* first;
+    size_t number;
+};
@@ -29,6 +29,129 @@ const std::map<std::string, NeuronValues> NeuronParam{
     {"LTS", {0.02, 0.25, -65., 2., 2.,  false}},
 };
 
+/*! @brief IntegrationMethod : numerical scheme used to integrate the membrane potential and the relaxation variable of a \ref Neurone during one time step.
+ - ORIGINAL : the scheme of the original model, two forward Euler half-steps on \p v with \p u fixed, then one Euler step on \p u (the step is ignored),
+ - EULER : forward Euler on ( \p v, \p u) with the given step,
+ - RK2 : Heun's method (second order Runge-Kutta) on ( \p v, \p u),
+ - RK4 : classical fourth order Runge-Kutta on ( \p v, \p u),
+ - ADAPTIVE : Bogacki-Shampine 3(2) pair with step size control, which takes the whole time step at once when the neuron is quiescent and smaller steps near the threshold.
+*/
+enum IntegrationMethod {ORIGINAL, EULER, RK2, RK4, ADAPTIVE};
+
+/*! @brief Integration gathers the numerical scheme, its step (for EULER, RK2 and RK4, in ms) and its tolerance on \p v (for ADAPTIVE, in mV).
+*/
+struct Integration {
+    IntegrationMethod method;
+    double step;
+    double tolerance;
+};
+
+/*! @brief IntegrationMethods associates the name given by the user to each \ref IntegrationMethod.
+*/
+const std::map<std::string, IntegrationMethod> IntegrationMethods{
+    {"original", ORIGINAL},
+    {"euler",    EULER},
+    {"rk2",      RK2},
+    {"rk4",      RK4},
+    {"adaptive", ADAPTIVE},
+};
+
+/*! @brief SynapseModel : time course of the current that a spike gives through a link.
+ - INSTANTANEOUS_SYNAPSES : the current of the original model, the strength of the link during the time step following the spike,
+ - CURRENT_SYNAPSES : a current which decays exponentially after the spike, with the same total charge,
+ - CONDUCTANCE_SYNAPSES : a conductance which decays exponentially, multiplied by the distance of the membrane potential to the reversal potential of the synapse (it gives the current of CURRENT_SYNAPSES at the rest potential).
+*/
+enum SynapseModel {INSTANTANEOUS_SYNAPSES, CURRENT_SYNAPSES, CONDUCTANCE_SYNAPSES};
+
+/*! @brief Synapses gathers the model of the synapses and the decay times (in ms) of the excitatory and inhibitory synapses (not used by INSTANTANEOUS_SYNAPSES).
+*/
+struct Synapses {
+    SynapseModel model;
+    double excitatoryTau;
+    double inhibitoryTau;
+};
+
+/*! @brief SynapseModels associates the name given by the user to each \ref SynapseModel.
+*/
+const std::map<std::string, SynapseModel> SynapseModels{
+    {"instantaneous", INSTANTANEOUS_SYNAPSES},
+    {"current",       CURRENT_SYNAPSES},
+    {"conductance",   CONDUCTANCE_SYNAPSES},
+};
+
+/*! @brief PageMode chooses the memory pages of the neurons and links of a network (see \ref Arena) : normal pages, transparent huge pages (the kernel is advised to use pages of 2 MiB) or explicit huge pages (taken from the pages reserved in /proc/sys/vm/nr_hugepages, or transparent huge pages if none is left).
+*/
+enum PageMode {NORMAL_PAGES, TRANSPARENT_HUGE_PAGES, EXPLICIT_HUGE_PAGES};
+
+/*! @brief PageModes associates the name given by the user to each \ref PageMode.
+*/
+const std::map<std::string, PageMode> PageModes{
+    {"normal",      NORMAL_PAGES},
+    {"transparent", TRANSPARENT_HUGE_PAGES},
+    {"explicit",    EXPLICIT_HUGE_PAGES},
+};
+
+/*! @brief StimulusKind : time course of an external current injected in some neurons (see \ref Stimuli).
+*/
+enum StimulusKind {STEP, PULSES, SINUSOID, POISSON, RECORDING};
+
+/*! @brief StimulusKinds associates the name used in the stimuli file to each \ref StimulusKind.
+*/
+const std::map<std::string, StimulusKind> StimulusKinds{
+    {"step",    STEP},
+    {"pulse",   PULSES},
+    {"sine",    SINUSOID},
+    {"poisson", POISSON},
+    {"file",    RECORDING},
+};
+
+/*! @brief Construction chooses how the links of a network are drawn (see \ref Network::Network()) : by shuffling all the neurons for each neuron (the sequence of the previous versions of the program, the memory and the time of the construction grow with the square of the number of neurons), or streamed directly in their final memory, in two passes (the number of links of every neuron, then the links of each neuron), or procedural (only the number of links of each neuron is stored, the links are computed again at each time step from the seed, see \ref ProceduralLinks).
+*/
+enum Construction {SHUFFLED_LINKS, STREAMED_LINKS, PROCEDURAL_LINKS};
+
+/*! @brief Constructions associates the name given by the user to each \ref Construction.
+*/
+const std::map<std::string, Construction> Constructions{
+    {"shuffle", SHUFFLED_LINKS},
+    {"stream",  STREAMED_LINKS},
+    {"procedural", PROCEDURAL_LINKS},
+};
+
+/*! @brief WeightPrecision chooses how the strengths of the links are stored (see \ref QuantizedLinks) : in double precision in the links of each neuron, or rounded to integers of 16 or 8 bits with a scale per neuron, in a compact array of the links of all the neurons.
+*/
+enum WeightPrecision {DOUBLE_WEIGHTS, SHORT_WEIGHTS, BYTE_WEIGHTS};
+
+/*! @brief WeightPrecisions associates the name given by the user to each \ref WeightPrecision.
+*/
+const std::map<std::string, WeightPrecision> WeightPrecisions{
+    {"double", DOUBLE_WEIGHTS},
+    {"16",     SHORT_WEIGHTS},
+    {"8",      BYTE_WEIGHTS},
+};
+
+/*! @brief SpikesFormat chooses the text of the spikes output file (see \ref Network::printSpikes()) : the raster (one line per time step with the state of every neuron), the events (one line per spike) or the ids (one line per time step with the indices of the neurons which fired).
+*/
+enum SpikesFormat {RASTER_SPIKES, EVENT_SPIKES, ID_SPIKES};
+
+/*! @brief SpikesFormats associates the name given by the user to each \ref SpikesFormat.
+*/
+const std::map<std::string, SpikesFormat> SpikesFormats{
+    {"raster", RASTER_SPIKES},
+    {"events", EVENT_SPIKES},
+    {"ids",    ID_SPIKES},
+};
+
+/*! @brief ParametersFormat chooses the format of the parameters of the neurons (see \ref ParameterColumns) : a text file (one line per neuron) or a binary file of columns.
+*/
+enum ParametersFormat {TEXT_PARAMETERS, COLUMN_PARAMETERS};
+
+/*! @brief ParametersFormats associates the name given by the user to each \ref ParametersFormat.
+*/
+const std::map<std::string, ParametersFormat> ParametersFormats{
+    {"text",    TEXT_PARAMETERS},
+    {"columns", COLUMN_PARAMETERS},
+};
+
 /*!
   A base class for TCLAP errors and output files error  thrown in this program and for the general constants used throughout the program. Other error types (std::invalid_argument) are handled directly in the program.
   Each error type has a specific exit code.
@@ -53,6 +176,7 @@ protected:
 /// *Specific error codes*
 _SIMULERR_(TCLAP_ERROR, 10)
 _SIMULERR_(OUTPUT_ERROR, 30)
+_SIMULERR_(INPUT_ERROR, 40)
 
 #undef _SIMULERR_
 
@@ -66,7 +190,37 @@ _SIMULERR_(OUTPUT_ERROR, 30)
 #define _DELTA_TEXT_ "Noise variable parameter. This parameter needs to be between 0 and 1. This parameter is necessary if you want to use the additional fonctionnality of the program which model a more rational model. If you want to use the program in its easier way, don't give a value to this argument. "
 #define _TYPES_TEXT_ "Proportions of each type of neurons (excitator : RS, IB, CH; inhibitor : FS, LTS). For exemple you can write : ’IB:0.2,FS:0.3,CH:0.2’. If the sum of the proportions is less than 1, the remaining neurons to be created will be RS. If the sum is more than 1, the proportions will be adapted in order to have the number of neurons requested."
 #define _OUTPUT_TEXT_ "Name of the file to print the results of the simulation (it will contains the spikes of each neurons during all the simulation, the parameters of each neurons and time dependant variables of a neuron sample)."
-#define _NETWORK_MODEL_TEXT_ "Model of the network that the user wish to simulate, either basic (B), constant (C) or overdispersed (O). These differents model influence how links between neurons are created. This program will not be launched if something else than B, C or O is specified. By default, the basic (Izhikevich) model is used."
+#define _STDP_TEXT_ "Enable spike-timing-dependent plasticity (STDP) : the strength of the links coming from excitatory neurons evolves during the simulation depending on the relative spike times of the neurons they connect."
+#define _WEIGHTS_PERIOD_TEXT_ "Period (in time-steps) at which the strengths of all the links are written in binary format in the output file which name has the suffix _weights.bin. Only used with STDP. By default (0), the strengths are not written."
+#define _INTEGRATION_TEXT_ "Numerical scheme used to update the neurons at each time-step : original (two Euler half-steps on the membrane potential, then one on the relaxation variable), euler, rk2, rk4 (with a fixed integration step) or adaptive (big steps when the neuron is quiescent, small steps near the threshold). By default, the original scheme is used."
+#define _SYNAPSES_TEXT_ "Time course of the current given by a spike through a link : instantaneous (the strength of the link during the next time-step, as in the original model), current (a current which decays exponentially, with the same total charge) or conductance (a conductance which decays exponentially, the current is proportional to the distance of the membrane potential to the reversal potential of the synapse : 0 mV for the excitatory ones, -80 mV for the inhibitory ones). Each neuron has one excitatory and one inhibitory variable which sum its synapses. By default, the synapses are instantaneous."
+#define _EXCITATORY_TAU_TEXT_ "Decay time (in ms) of the excitatory synapses, with the current or conductance synapses."
+#define _INHIBITORY_TAU_TEXT_ "Decay time (in ms) of the inhibitory synapses, with the current or conductance synapses."
+#define _INTEGRATION_STEP_TEXT_ "Integration step (in ms, at most 1) of the euler, rk2 and rk4 schemes."
+#define _INTEGRATION_TOLERANCE_TEXT_ "Tolerance (in mV) on the local error of the membrane potential for the adaptive scheme."
+#define _COMPRESSION_TEXT_ "Write the three output files compressed in gzip format (suffix .gz). The files are compressed by large blocks on separate threads and can be read with zcat, the decompress tool of this program or RasterPlots.R, even while the simulation is running."
+#define _PACE_TEXT_ "Pace of the simulation : number of time-steps (of 1 ms) simulated per ms of wall-clock time, for example 1 to run in real time or 0.5 to run twice slower. Each time-step then starts at its time on the wall-clock (the simulation waits if it is early), its latency (from this time to the end of its update) is measured, and the deadline misses (latencies above the duration of a time-step) and the percentiles of the latencies are written on the terminal and in the output file which name has the suffix _latency. By default (0), the simulation runs as fast as possible."
+#define _METRICS_TEXT_ "Name of a Unix domain socket on which the progress of the simulation is served while it runs (current time-step, time-steps per second, firing rate of each neuron type, resident memory and size of the output files, see the documentation of the class MetricsServer), for example to watch a long run with: socat - UNIX-CONNECT:name. By default, no socket is created."
+#define _SPIKE_RING_TEXT_ "Name of a POSIX shared memory object (for example /neurons) in which the spikes of each time-step are published while the simulation runs, in a ring of the last time-steps (see the documentation of the classes SpikeRing and SpikeReader), so that analysis or visualization programs on the same machine can read them live without the output files, for example with: readSpikes /neurons. The simulation never waits for the readers. By default, no shared memory is created."
+#define _QUIESCENCE_TEXT_ "Stop the simulation before its duration when no neuron fired during this number of time-steps (the activity died out). The time-step and the reason of the stop are written on the terminal and in the output file which name has the suffix _stop. By default (0), this criterion is not used."
+#define _STEADY_WINDOW_TEXT_ "Stop the simulation before its duration when the variance of the population firing rate over a sliding window of this number of time-steps is below the steady variance (the activity is stationary). The time-step and the reason of the stop are written on the terminal and in the output file which name has the suffix _stop. By default (0), this criterion is not used."
+#define _STEADY_VARIANCE_TEXT_ "Variance (in Hz^2) of the population firing rate, one value per time-step, below which the window of the steady state stops the simulation."
+#define _ACCURACY_TEXT_ "With quantized links (option -Q), number of time-steps at the beginning of the simulation during which the same network with its strengths in double precision is simulated beside it, to compare their firing statistics : number of spikes, firing rate and Fano factor of each neuron type, written in the output file which name has the suffix _accuracy. By default (0), there is no comparison."
+#define _STATISTICS_TEXT_ "Window (in time-steps) of the population statistics computed during the simulation : firing rate of each neuron type per window, spike count of each neuron, inter-spike intervals histograms and synchrony measures, written in the output file which name has the suffix _statistics. By default (0), no statistics are computed."
+#define _NO_SPIKES_TEXT_ "Do not write the spikes output file (useful with the statistics, which summarize the spikes)."
+#define _PAGES_TEXT_ "Memory pages of the neurons and links : normal, transparent (transparent huge pages) or explicit (reserved huge pages, transparent ones if none is left). With huge pages, the placement of the memory (huge pages and NUMA nodes) is written on the terminal. By default, normal pages are used."
+#define _CONSTRUCTION_TEXT_ "Construction of the links : shuffle (all the neurons are shuffled to choose the links of each neuron, as in the previous versions) stream (the links are drawn directly in their final memory, for big networks) or procedural (the links are not stored but computed again at each time-step from the seed, for networks with more links than the memory can hold, slower; not with the plasticity or quantized strengths). With stream or procedural, the memory used by the construction is written on the terminal. By default, the links are shuffled."
+#define _SPIKES_FORMAT_TEXT_ "Format of the spikes output file : raster (one line per time-step, the time then 0 or 1 for each neuron), events (one line per spike : time neuron) or ids (one line per time-step : the time then the indices of the neurons which fired). The events and ids files start with a comment line giving the number of neurons, their size is proportional to the number of spikes, and RasterPlots.R reads the three formats. By default, the raster is written."
+#define _PARAMETERS_FORMAT_TEXT_ "Format of the parameters of the neurons : text (the output file which name has the suffix _parameters.txt, one line per neuron) or columns (a binary file of columns which name has the suffix _parameters.bin, see the documentation of the class ParameterColumns, much faster to write and to read for big networks). By default, the text file is written."
+#define _WEIGHTS_TEXT_ "Precision of the strengths of the links : double, 16 or 8 (the strengths are rounded to integers of 16 or 8 bits, with a scale for each neuron, and the links take 6 or 5 bytes instead of 16, for big networks; not with the plasticity). With 16 or 8, the memory of the links and the largest rounding of a strength are written on the terminal. By default, the strengths are doubles."
+#define _DENSE_THRESHOLD_TEXT_ "Density of the links (mean connectivity / (number of neurons - 1)) above which the links are stored in a dense matrix of single precision strengths instead of the neurons, to compute the synaptic currents with contiguous additions instead of following the links of each neuron (not with the plasticity, the quantized or the procedural links). The matrix takes 4 bytes per pair of neurons against 16 bytes per link in the neurons, so above the default density it takes less memory; a lower threshold (for example 0.1) trades memory for speed. Above 1, the dense matrix is never used."
+#define _SEED_TEXT_ "Seed of the random generators of the simulation (0 : a random seed, only without MPI). Two simulations with the same seed and the same parameters give the same results."
+#define _STIMULI_TEXT_ "File describing the external currents injected in some neurons during the simulation (steps, pulses, sinusoids, Poisson spike trains or binary recordings), one stimulus per line : kind targets start end amplitude parameters (see the documentation of the class Stimuli). By default, the neurons only receive the noise and the current of their links."
+#define _PROBES_TEXT_ "Neurons whose time dependent variables are recorded in the output file which name has the suffix _probes, separated by commas : an index (17), a type followed by a number of neurons (RS:3 for the 3 first RS neurons) or random followed by a number of neurons (random:10). By default, no neuron is recorded."
+#define _PROBE_VARIABLES_TEXT_ "Variables recorded for each probe, separated by commas, among v (membrane potential), u (relaxation variable), I (current) and firing."
+#define _PROBE_STRIDE_TEXT_ "The probes are recorded every probe stride time-steps."
+#define _NETWORK_MODEL_TEXT_ "Model of the network that the user wish to simulate, either basic (B), constant (C), overdispersed (O), small-world (W, Watts-Strogatz : a ring lattice whose links are rewired with the rewiring probability) or scale-free (A, Barabasi-Albert : preferential attachment, a power law distribution of the number of links). These differents model influence how links between neurons are created. This program will not be launched if something else than B, C, O, W or A is specified. The small-world and scale-free links can not be procedural. By default, the basic (Izhikevich) model is used."
+#define _REWIRING_TEXT_ "Rewiring probability of the links of the small-world model (option -M W), between 0 (ring lattice, each neuron receives links from its nearest neighbours) and 1 (random network)."
 
 /// * default parameters values in the program *
 #define _T_ 30 // discharge threshold T = 30 [mV] corresponds to the potential value at which the neuron transmits a pulse along its axon.
@@ -81,5 +235,109 @@ _SIMULERR_(OUTPUT_ERROR, 30)
 #define _MEAN_INTENSITY_ 0.5
 #define _DELTA_ -1.0
 #define _NETWORK_MODEL_ 'B'
+#define _REWIRING_ 0.1
 #define _OUTFILE_NAME_ "test100"
 #define _PROPORTIONS_ "IB:0.1,LTS:0.2,FS:0.3,CH:0.2"
+#define _WEIGHTS_PERIOD_ 0
+#define _INTEGRATION_ "original"
+#define _INTEGRATION_STEP_ 0.5
+#define _SYNAPSES_ "instantaneous"
+#define _EXCITATORY_TAU_ 5.0 // decay time of the AMPA synapses, in ms
+#define _INHIBITORY_TAU_ 10.0 // decay time of the GABA-A synapses, in ms
+#define _EXCITATORY_REVERSAL_ 0.0 // reversal potentials of the conductance synapses, in mV
+#define _INHIBITORY_REVERSAL_ -80.0
+#define _REST_POTENTIAL_ -65.0 // potential at which a conductance synapse gives the current of a current synapse
+#define _INTEGRATION_TOLERANCE_ 1e-3
+#define _COMPRESSION_BLOCK_SIZE_ (1 << 22) // 4 MiB of text are compressed at once
+#define _COMPRESSION_LEVEL_ 6
+#define _COMPRESSION_QUEUE_ 4 // maximal number of blocks waiting to be compressed
+#define _OUTPUT_QUEUE_ 4 // maximal number of blocks waiting to be written by the output thread of a paced simulation
+#define _STATISTICS_WINDOW_ 0
+#define _ACCURACY_STEPS_ 0
+#define _ACCURACY_WINDOW_ 50 // time steps of the windows of the Fano factors compared by the accuracy report
+#define _QUIESCENCE_ 0
+#define _STEADY_WINDOW_ 0
+#define _STEADY_VARIANCE_ 1.0
+#define _PACE_ 0.0
+#define _METRICS_PERIOD_ 1.0 // the metrics served on the socket are published every second of wall-clock time
+#define _SPIKE_RING_SLOTS_ 1024 // time-steps kept in the shared memory of the spikes
+#define _LATENCY_PRECISION_BITS_ 7 // the latencies are counted with a relative precision of 1/64
+#define _ISI_BINS_ 200 // the inter-spike intervals histograms have one bin per ms up to 200 ms, and one bin for the longer intervals
+#define _INTEGRATION_MIN_STEP_ (1.0/64) // smallest step taken by the adaptive scheme
+#define _PROBES_ ""
+#define _PROBE_VARIABLES_ "v,u,I,firing"
+#define _PROBE_STRIDE_ 1
+#define _PROBE_BUFFER_ROWS_ 1024 // records kept in memory before they are written
+#define _ARENA_BLOCK_SIZE_ (1 << 20) // the neurons and their links are allocated by blocks of 1 MiB
+#define _PAGES_ "normal"
+#define _CONSTRUCTION_ "shuffle"
+#define _PARAMETERS_FORMAT_ "text"
+#define _SPIKES_FORMAT_ "raster"
+#define _WEIGHTS_ "double"
+#define _HUGE_PAGE_SIZE_ (1 << 21) // 2 MiB, the size of the huge pages on x86-64
+#define _DENSE_THRESHOLD_ 0.25 // 4 bytes per pair of neurons in the dense matrix against 16 bytes per link in the neurons : above this density the matrix takes less memory
+#define _FEISTEL_ROUNDS_ 4 // rounds (an even number) of the permutations which give the procedural links
+#define _DENSE_BLOCK_ 2048 // neurons whose sums stay in the cache while the rows of the firing neurons are added
+#define _TEXT_BUFFER_SIZE_ (1 << 20) // 1 MiB of text is formatted before it is written in its output file
+#define _STIMULUS_BUFFER_STEPS_ 4096 // time steps of a recorded stimulus read at once
+#define _SEED_ 857298564279165
+#define _STREAMS_ 3 // random sequences of a simulation : the network (0), the Poisson stimuli (1) and the random choices of neurons (2)
+
+/// *default values for the spike-timing-dependent plasticity (amplitudes are relative to the maximal strength of a link, time constants are in time steps) *
+#define _STDP_A_PLUS_ 0.01
+#define _STDP_A_MINUS_ 0.012
+#define _STDP_TAU_PLUS_ 20.0
+#define _STDP_TAU_MINUS_ 20.0
+
+/*! @brief Configuration gathers all the parameters of a \ref Simulation, with their default values : it is filled by the command line of the Neurons program, or directly by a program using the library (see \ref Simulation::Simulation()).
+ The meaning of each parameter is given by the help text of the corresponding option (./Neurons -h).
+*/
+struct Configuration {
+    size_t neuronNumber = _NEURON_NUMBER_;
+    double excitatoryProportion = _PROPORTION_EXCITATOR_;
+    ///proportions of each type (for example IB:0.2,FS:0.3), used instead of the excitatory proportion if not empty
+    std::string proportions = "";
+    double meanConnectivity = _MEAN_CONNECTIVITY_;
+    double meanIntensity = _MEAN_INTENSITY_;
+    double delta = _DELTA_;
+    char networkModel = _NETWORK_MODEL_;
+    ///rewiring probability of the small-world model
+    double rewiring = _REWIRING_;
+    ///seed of the random generators and index of the simulation among the ones using the same seed (see \ref RandomNumbers)
+    unsigned long int seed = _SEED_;
+    unsigned long int stream = 0;
+    size_t duration = _SIMULATION_TIME_;
+    Integration integration = {ORIGINAL, _INTEGRATION_STEP_, _INTEGRATION_TOLERANCE_};
+    Synapses synapses = {INSTANTANEOUS_SYNAPSES, _EXCITATORY_TAU_, _INHIBITORY_TAU_};
+    PageMode pages = NORMAL_PAGES;
+    Construction construction = SHUFFLED_LINKS;
+    WeightPrecision weights = DOUBLE_WEIGHTS;
+    bool stdp = false;
+    double denseThreshold = _DENSE_THRESHOLD_;
+    size_t weightsPeriod = _WEIGHTS_PERIOD_;
+    ///file of the stimuli, none if empty
+    std::string stimuli = "";
+    ///neurons recorded by the probes, none if empty
+    std::string probes = _PROBES_;
+    std::string probeVariables = _PROBE_VARIABLES_;
+    size_t probeStride = _PROBE_STRIDE_;
+    size_t statisticsWindow = _STATISTICS_WINDOW_;
+    ///time steps of the comparison of the quantized links with the double precision (0 : no comparison)
+    size_t accuracySteps = _ACCURACY_STEPS_;
+    ///stopping criteria : time-steps without spike, and window and variance threshold of the steady state (0 : not used)
+    size_t quiescence = _QUIESCENCE_;
+    size_t steadyWindow = _STEADY_WINDOW_;
+    double steadyVariance = _STEADY_VARIANCE_;
+    ///time-steps per ms of wall-clock time (0 : as fast as possible)
+    double pace = _PACE_;
+    ///Unix socket of the metrics served during the run, none if empty
+    std::string metricsSocket = "";
+    ///POSIX shared memory in which the spikes are published during the run, none if empty
+    std::string spikeRing = "";
+    ///the output files are only written by Simulation::run()
+    std::string outfileName = _OUTFILE_NAME_;
+    bool spikesOutput = true;
+    SpikesFormat spikesFormat = RASTER_SPIKES;
+    ParametersFormat parametersFormat = TEXT_PARAMETERS;
+    bool compression = false;
+};
@@ -0,0 +1,64 @@
+#include <zlib.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/*
+ Decompression tool for the output files written with the option -Z (see CompressedOutput.h).
+ Usage : ./decompress [-f] file.gz [output]
+ The decompressed text is written in the output file, or on the terminal if no output file is given.
+ With -f (follow), the file is read while the simulation is writing it : the tool waits for the new blocks until it is interrupted (Ctrl-C).
+*/
+
+int main(int argc, char **argv)
+{
+    bool follow(argc>1 and std::strcmp(argv[1], "-f")==0);
+    int first(follow ? 2 : 1);
+    if (argc<=first or argc>first+2) {
+        std::cerr << "Usage : " << argv[0] << " [-f] file.gz [output]" << std::endl;
+        return 1;
+    }
+
+    gzFile infile(gzopen(argv[first], "rb"));
+    if (!infile) {
+        std::cerr << "The file " << argv[first] << " can not be opened." << std::endl;
+        return 30;
+    }
+    FILE* outfile(argc==first+2 ? std::fopen(argv[first+1], "wb") : stdout);
+    if (!outfile) {
+        std::cerr << "The file " << argv[first+1] << " can not be opened." << std::endl;
+        gzclose(infile);
+        return 30;
+    }
+
+    std::string buffer(1 << 20, '\0');
+    int code(0);
+    while (true) {
+        int read(gzread(infile, &buffer[0], buffer.size()));
+        if (read>0) {
+            std::fwrite(buffer.data(), 1, read, outfile);
+            continue;
+        }
+        int error(Z_OK);
+        const char* message(gzerror(infile, &error));
+        if (read<0 or (error!=Z_OK and error!=Z_BUF_ERROR)) {
+            std::cerr << "The file " << argv[first] << " is corrupted : " << message << std::endl;
+            code = 30;
+            break;
+        }
+        if (!follow) {
+            if (error==Z_BUF_ERROR) std::cerr << "The file " << argv[first] << " ends with an incomplete block (is it still being written ?)." << std::endl;
+            break;
+        }
+        std::fflush(outfile);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500)); // wait for the next block of the simulation
+        gzclearerr(infile);
+    }
+
+    gzclose(infile);
+    if (outfile!=stdout) std::fclose(outfile);
+    return code;
+}
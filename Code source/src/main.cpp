@@ -55,25 +55,26 @@ Rscript RasterPlots.R test10000_spikes.txt test10000_sample_neurons.txt test1000
 
 */
 
-RandomNumbers *_RNG = new RandomNumbers(857298564279165);
-
 int main(int argc, char **argv)
 {
+    Communicator communicator(argc, argv); // only one process if the program is not compiled with MPI (see Communicator.h)
+
     try {
 
-        Simulation s(argc, argv);
+        Simulation s(argc, argv, &communicator);
         s.run();
 
     } catch(SimulError &e) {
         std::cerr << e.what() << std::endl;
+        communicator.abort(e.value());
         return e.value();
     } catch(TCLAP::ArgException &e) {
+        communicator.abort(TCLAP_ERROR("").value());
         throw(TCLAP_ERROR("Error: " + e.error() + " " + e.argId()));
     } catch (std::invalid_argument &ee) {
         std::cerr<<ee.what()<<std::endl;
+        communicator.abort(1);
     }
 
-    if (_RNG) delete _RNG;
-
     return 0;
 }
@@ -0,0 +1,53 @@
+#include "SpikeReader.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+/*
+ Reading tool for the spikes published in shared memory with the option -y (see SpikeRing.h and SpikeReader.h).
+ Usage : ./readSpikes name [output]
+ The spikes are written as the ids format of the spikes output file (one line per time step : the time then the indices of the neurons which fired), in the output file or on the terminal, while the simulation runs and until it is over.
+ The number of time steps lost (overwritten by the simulation before they were read) is written at the end.
+*/
+
+int main(int argc, char **argv)
+{
+    if (argc<2 or argc>3) {
+        std::cerr << "Usage : " << argv[0] << " name [output]" << std::endl;
+        return 1;
+    }
+    FILE* outfile(argc==3 ? std::fopen(argv[2], "w") : stdout);
+    if (!outfile) {
+        std::cerr << "The file " << argv[2] << " can not be opened." << std::endl;
+        return 30;
+    }
+
+    try {
+        SpikeReader reader(argv[1]);
+        std::fprintf(outfile, "# spikes of %zu neurons : time ids\n", reader.getNumberNeurons());
+        std::vector<size_t> fired;
+        size_t time;
+        while (true) {
+            bool closed(reader.isClosed()); // read before the last time steps, which are published first
+            if (reader.next(time, fired)) {
+                std::fprintf(outfile, "%zu", time);
+                for (auto i : fired) std::fprintf(outfile, " %zu", i);
+                std::fputc('\n', outfile);
+            } else if (closed) {
+                break;
+            } else {
+                std::fflush(outfile);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1)); // wait for the next time step of the simulation
+            }
+        }
+        if (reader.getLost()>0) std::cerr << reader.getLost() << " time steps were overwritten before they were read." << std::endl;
+    } catch(SimulError& e) {
+        std::cerr << e.what() << std::endl;
+        if (outfile!=stdout) std::fclose(outfile);
+        return e.value();
+    }
+
+    if (outfile!=stdout) std::fclose(outfile);
+    return 0;
+}
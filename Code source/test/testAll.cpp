@@ -1,20 +1,36 @@
 #include <gtest/gtest.h>
 #include "constants.h"
 #include "Simulation.h"
+#include "AsyncOutput.h"
 #include "Random.h"
-
-RandomNumbers *_RNG = new RandomNumbers(23948710923);
+#include "Statistics.h"
+#include "Recorder.h"
+#include "SpikeReader.h"
+#include "Topology.h"
+#include <set>
+#include <chrono>
+#ifdef __unix__
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#ifdef NEURONS_ZLIB
+#include "CompressedOutput.h"
+#include <zlib.h>
+#endif
 
 //tests for class Random
 TEST(Random, distributions)
 {
+    RandomNumbers generator(_SEED_);
     double mean = 0;
     double input_mean(1.35), input_sd(2.8);
     std::vector<double> res;
     res.resize(10000);
     double delta = input_sd*sqrt(3.0);
     double lower = input_mean-delta, upper = input_mean+delta;
-    _RNG->uniform_double(res, lower, upper);
+    generator.uniform_double(res, lower, upper);
     for (auto I : res) {
         EXPECT_GE(I, lower);
         EXPECT_LT(I, upper);
@@ -22,7 +38,7 @@ TEST(Random, distributions)
     }
     EXPECT_NEAR(input_mean, mean, 3e-2*input_sd);
 
-    _RNG->exponential(input_mean);
+    generator.exponential(input_mean);
     mean = 0;
     for (auto I : res) mean += I*1e-4;
     EXPECT_NEAR(input_mean, mean, 2e-2*input_mean);
@@ -30,10 +46,11 @@ TEST(Random, distributions)
 
 TEST(Random, Shuffle) //check if the table is well mixed otherwise all neurons will be linked to the same ones
 {
+    RandomNumbers generator(_SEED_);
     std::vector<size_t> toShuffle(_NEURON_NUMBER_);
     std::iota(toShuffle.begin(), toShuffle.end(),0);
     std::vector<size_t> control = toShuffle;
-    _RNG->shuffle(toShuffle);
+    generator.shuffle(toShuffle);
     bool isSame(toShuffle==control);
     EXPECT_FALSE(isSame);
 }
@@ -159,8 +176,9 @@ TEST(Network, RandomStrength)
 
 TEST(Network, findNeuron)
 {
+    RandomNumbers generator(_SEED_);
     Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
-    Neurone neuron("FS");
+    Neurone neuron("FS", generator);
     size_t find = network.findNeuron(&neuron);
     EXPECT_EQ(find,size_t(_NEURON_NUMBER_));
 }
@@ -192,16 +210,17 @@ TEST (Network, InhibExciProportion)
 //tests for class Neurone
 TEST(Neurone, update_case_excitation)
 {
-    Neurone neurone_FS("FS");
-    Neurone neurone_newlink_RS("RS");
-    Neurone neurone_newlink_FS("FS");
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_FS("FS", generator);
+    Neurone neurone_newlink_RS("RS", generator);
+    Neurone neurone_newlink_FS("FS", generator);
     neurone_newlink_RS.setFiringState(true);
     neurone_newlink_FS.setFiringState(true);
     neurone_FS.addLink(&neurone_newlink_RS, 30);
     neurone_FS.addLink(&neurone_newlink_FS, 1);
     bool test(false);
     for(int i(0); i<10; ++i) { //since the strength with the excitatory neuron is so high, the neuron will fire at least one time
-        neurone_FS.computeI();
+        neurone_FS.computeI(generator);
         neurone_FS.update();
         if(neurone_FS.isFiring()) {
             test = true;
@@ -213,16 +232,17 @@ TEST(Neurone, update_case_excitation)
 
 TEST(Neurone, update_case_inhibition)
 {
-    Neurone neurone_FS("FS");
-    Neurone neurone_newlink_RS("RS");
-    Neurone neurone_newlink_FS("FS");
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_FS("FS", generator);
+    Neurone neurone_newlink_RS("RS", generator);
+    Neurone neurone_newlink_FS("FS", generator);
     neurone_newlink_RS.setFiringState(true);
     neurone_newlink_FS.setFiringState(true);
     neurone_FS.addLink(&neurone_newlink_RS, 1);
     neurone_FS.addLink(&neurone_newlink_FS, 30);
     bool test(false);
     for(int i(0); i<10; ++i) { //since the strength with the inhibitory neuron is so high, the neuron will never fire
-        neurone_FS.computeI();
+        neurone_FS.computeI(generator);
         neurone_FS.update();
         if(neurone_FS.isFiring()) {
             test = true;
@@ -232,12 +252,49 @@ TEST(Neurone, update_case_inhibition)
     EXPECT_FALSE(test);
 }
 
+TEST(Neurone, integration_original)
+{
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_IB("IB", generator);
+    neurone_IB.setCurrent(10);
+    Neurone copy(neurone_IB);
+    for(int i(0); i<100; ++i) {
+        neurone_IB.update();
+        copy.update({ORIGINAL, 0.1, 1.0}); // the step is ignored by the original scheme
+        EXPECT_EQ(neurone_IB.getPotential(), copy.getPotential());
+        EXPECT_EQ(neurone_IB.getRelaxation(), copy.getRelaxation());
+    }
+}
+
+TEST(Neurone, integration_schemes)
+{
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_RS("RS", generator);
+    neurone_RS.setCurrent(3); // subthreshold : the neuron relaxes to a fixed point
+    Neurone reference(neurone_RS), rk4(neurone_RS), adaptive(neurone_RS);
+    size_t evaluations(0);
+    for(int i(0); i<20; ++i) {
+        reference.update({RK4, 1.0/256, 1.0});
+        rk4.update({RK4, 0.25, 1.0});
+        evaluations += adaptive.update({ADAPTIVE, 1.0, 1e-4});
+        EXPECT_NEAR(reference.getPotential(), rk4.getPotential(), 1e-3);
+        EXPECT_NEAR(reference.getPotential(), adaptive.getPotential(), 1e-2);
+        EXPECT_NEAR(reference.getRelaxation(), adaptive.getRelaxation(), 1e-2);
+    }
+    EXPECT_LT(evaluations, size_t(20*4*256)); // much less work than the reference
+
+    Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    EXPECT_THROW(network.setIntegration({RK2, 2.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(network.setIntegration({ADAPTIVE, 0.5, 0.0}), std::invalid_argument);
+}
+
 TEST(Neurone, check_addLink)
 {
-    Neurone neurone_FS ("FS");
-    Neurone neurone_newlink_RS("RS");
-    Neurone neurone_newlink_FS("FS");
-    Neurone neurone_notlinked_FS("FS");
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_FS ("FS", generator);
+    Neurone neurone_newlink_RS("RS", generator);
+    Neurone neurone_newlink_FS("FS", generator);
+    Neurone neurone_notlinked_FS("FS", generator);
     neurone_FS.addLink(&neurone_newlink_RS, 3);
     neurone_FS.addLink(&neurone_newlink_FS, 5);
 
@@ -250,13 +307,14 @@ TEST(Neurone, check_addLink)
 
 TEST(Neurone, check_neighborhood_sums)
 {
-    Neurone neurone_FS ("FS");
-    Neurone neurone_newlink_RS("RS");
-    Neurone neurone_newlink_FS("FS");
-    Neurone neurone_newlink_RS2("RS");
-    Neurone neurone_newlink_FS2("FS");
-    Neurone neurone_newlink_RS3("RS");
-    Neurone neurone_newlink_FS3("FS");
+    RandomNumbers generator(_SEED_);
+    Neurone neurone_FS ("FS", generator);
+    Neurone neurone_newlink_RS("RS", generator);
+    Neurone neurone_newlink_FS("FS", generator);
+    Neurone neurone_newlink_RS2("RS", generator);
+    Neurone neurone_newlink_FS2("FS", generator);
+    Neurone neurone_newlink_RS3("RS", generator);
+    Neurone neurone_newlink_FS3("FS", generator);
 
     neurone_newlink_RS.setFiringState(true);
     neurone_newlink_FS.setFiringState(true);
@@ -276,6 +334,1064 @@ TEST(Neurone, check_neighborhood_sums)
     EXPECT_NEAR(10, neurone_FS.getSumInhibitor(), 1e-12);
 }
 
+//tests for class Plasticity
+TEST(Plasticity, PotentiationAndDepression)
+{
+    Network network(_NEURON_NUMBER_,1.0,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, 'C'); // only excitatory neurons, each one receives exactly _MEAN_CONNECTIVITY_ links
+    Neurons neurons = network.getNeurons();
+    network.enablePlasticity();
+    Plasticity* plasticity = network.getPlasticity();
+    EXPECT_EQ(plasticity->getNumberLinks(), size_t(_NEURON_NUMBER_*_MEAN_CONNECTIVITY_));
+
+    size_t post(0);
+    size_t pre(network.findNeuron(neurons[post]->getLink(0).neurone));
+    double maxStrength(2*_MEAN_INTENSITY_);
+    double before(neurons[post]->getLink(0).bondStrength);
+
+    plasticity->onSpikes({pre}, 1); // pre before post : the link is strengthened
+    EXPECT_NEAR(1.0, plasticity->getPreTrace(pre, 1), 1e-12);
+    plasticity->onSpikes({post}, 3);
+    double expected(std::min(maxStrength, before + _STDP_A_PLUS_*maxStrength*std::exp(-2.0/_STDP_TAU_PLUS_)));
+    EXPECT_NEAR(expected, neurons[post]->getLink(0).bondStrength, 1e-12);
+
+    plasticity->onSpikes({pre}, 4); // post before pre : the link is weakened
+    expected = std::max(0.0, expected - _STDP_A_MINUS_*maxStrength*std::exp(-1.0/_STDP_TAU_MINUS_));
+    EXPECT_NEAR(expected, neurons[post]->getLink(0).bondStrength, 1e-12);
+}
+
+TEST(Plasticity, WeightsBounded)
+{
+    Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    network.enablePlasticity(1.0, 1.0); // huge amplitudes to reach the bounds
+    for (size_t t(0); t<200; ++t) network.update();
+    for (const auto& neuron : network.getNeurons()) {
+        for (size_t k(0); k<neuron->getSizeNeighborhood(); ++k) {
+            EXPECT_GE(neuron->getLink(k).bondStrength, 0.0);
+            EXPECT_LE(neuron->getLink(k).bondStrength, 2*_MEAN_INTENSITY_);
+        }
+    }
+}
+
+TEST(OutputFile, WeightsDump)
+{
+    Simulation simulation;
+    simulation.getNetwork()->enablePlasticity();
+    simulation.setWeightsPeriod(5);
+    simulation.run();
+    size_t links(simulation.getNetwork()->getPlasticity()->getNumberLinks());
+    std::ifstream weights(std::string(_OUTFILE_NAME_)+"_weights.bin", std::ios_base::binary | std::ios_base::ate);
+    size_t snapshot((3 + _NEURON_NUMBER_+1 + links)*sizeof(uint64_t) + links*sizeof(double));
+    EXPECT_EQ(size_t(weights.tellg()), (_SIMULATION_TIME_/5)*snapshot);
+}
+
+//tests for class Statistics
+TEST(Statistics, RatesAndIntervals)
+{
+    Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    Statistics statistics(network, 10);
+    std::vector<size_t> all(_NEURON_NUMBER_);
+    std::iota(all.begin(), all.end(), 0);
+    for (size_t t(1); t<=100; ++t) {
+        if (t%5==0) statistics.record(all, t); // every neuron fires every 5 ms : 200 Hz, perfectly synchronous
+        else statistics.record({}, t);
+    }
+    for (auto count : statistics.getSpikeCounts()) EXPECT_EQ(size_t(20), count);
+    ASSERT_EQ(size_t(10), statistics.getRates().size());
+    for (const auto& window : statistics.getRates()) {
+        for (auto rate : window) EXPECT_NEAR(200.0, rate, 1e-9);
+    }
+    for (size_t t(0); t<statistics.getTypes().size(); ++t) {
+        EXPECT_GT(statistics.getIntervals(t)[4], size_t(0)); // all the intervals last 5 ms
+        EXPECT_EQ(std::accumulate(statistics.getIntervals(t).begin(), statistics.getIntervals(t).end(), size_t(0)), statistics.getIntervals(t)[4]);
+    }
+    EXPECT_NEAR(1.0, statistics.getSynchrony(), 1e-9);
+    EXPECT_NEAR(0.0, statistics.getFanoFactor(), 1e-9);
+}
+
+TEST(OutputFile, StatisticsWithoutSpikes)
+{
+    std::remove((std::string(_OUTFILE_NAME_)+"_spikes.txt").c_str());
+    Simulation simulation;
+    simulation.setStatistics(5, false);
+    simulation.run();
+    EXPECT_FALSE(std::ifstream(std::string(_OUTFILE_NAME_)+"_spikes.txt").good());
+    std::ifstream statistics(std::string(_OUTFILE_NAME_)+"_statistics.txt");
+    std::string line;
+    size_t neurons(0);
+    bool counts(false);
+    while (std::getline(statistics, line)) {
+        if (counts and line.find("neuron")!=0) ++neurons;
+        if (line.find("# number of spikes")==0) counts = true;
+    }
+    EXPECT_EQ(size_t(_NEURON_NUMBER_), neurons);
+}
+
+TEST(Arena, BlocksAndAlignment)
+{
+    Arena arena(256);
+    char* small(static_cast<char*>(arena.allocate(3, 1)));
+    double* aligned(static_cast<double*>(arena.allocate(10*sizeof(double), alignof(double))));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(aligned)%alignof(double));
+    EXPECT_GE(reinterpret_cast<char*>(aligned), small+3); // the areas do not overlap
+    arena.allocate(1000); // bigger than a block
+    EXPECT_EQ(size_t(3+10*sizeof(double)+1000), arena.getUsed());
+    EXPECT_GE(arena.getReserved(), arena.getUsed());
+
+    Links links{ArenaAllocator<NeuroneInteraction>(&arena)};
+    links.push_back({nullptr, 1.0});
+    Links copy(links); // a copy does not depend on the arena
+    EXPECT_EQ(nullptr, copy.get_allocator().getArena());
+    EXPECT_EQ(1.0, copy[0].bondStrength);
+}
+
+TEST(Arena, HugePages)
+{
+    for (auto pages : {TRANSPARENT_HUGE_PAGES, EXPLICIT_HUGE_PAGES}) { // without reserved huge pages, the explicit ones fall back to the transparent ones
+        Arena arena(1000, pages);
+        char* area(static_cast<char*>(arena.allocate(3*_HUGE_PAGE_SIZE_/2, 64)));
+        std::fill(area, area+3*_HUGE_PAGE_SIZE_/2, 1); // first touch
+        EXPECT_EQ(0u, arena.getReserved()%_HUGE_PAGE_SIZE_);
+        size_t pagesInMemory(0);
+        for (const auto& node : arena.getNodes()) {
+            if (node.first>=0) pagesInMemory += node.second;
+        }
+#ifdef __linux__
+        EXPECT_GT(pagesInMemory, size_t(0));
+#endif
+        EXPECT_LE(arena.getHugePages(), arena.getReserved());
+    }
+}
+
+TEST(Neurone, allocateLinks)
+{
+    RandomNumbers generator(_SEED_);
+    Arena arena;
+    Neurone neuron("RS", generator), linked("FS", generator);
+    neuron.addLink(&linked, 1.0);
+    neuron.allocateLinks(3, &arena); // the existing links are kept
+    size_t used(arena.getUsed());
+    EXPECT_EQ(3*sizeof(NeuroneInteraction), used);
+    neuron.addLink(&linked, 2.0);
+    neuron.addLink(&linked, 3.0);
+    EXPECT_EQ(used, arena.getUsed()); // no more allocation
+    ASSERT_EQ(size_t(3), neuron.getSizeNeighborhood());
+    EXPECT_EQ(&linked, neuron.getLink(0).neurone);
+    EXPECT_EQ(3.0, neuron.getLink(2).bondStrength);
+}
+
+TEST(Recorder, ResolveAndRecord)
+{
+    Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    Recorder recorder(network, "3,RS:2,random:4", "v,firing", 2, 3);
+    ASSERT_EQ(size_t(7), recorder.getProbes().size());
+    EXPECT_EQ(size_t(3), recorder.getProbes()[0]);
+    for (size_t p(1); p<3; ++p) EXPECT_TRUE(network.getNeurons()[recorder.getProbes()[p]]->isType("RS"));
+    EXPECT_EQ(recorder.getProbes(), Recorder(network, "3,RS:2,random:4").getProbes()); // the random probes do not depend on the simulation
+    EXPECT_THROW(Recorder(network, "XX:2"), std::invalid_argument);
+    EXPECT_THROW(Recorder(network, "3", "w"), std::invalid_argument);
+
+    for (size_t t(1); t<=6; ++t) {
+        network.update();
+        recorder.record(t);
+    }
+    ASSERT_TRUE(recorder.isFull()); // times 2, 4 and 6
+    EXPECT_DOUBLE_EQ(network.getNeurons()[3]->getPotential(), recorder.getRecords()[2*7*2]);
+    std::stringstream outfile;
+    recorder.header(outfile);
+    recorder.flush(outfile);
+    EXPECT_EQ(size_t(0), recorder.getNumberRecords());
+    std::string line;
+    std::getline(outfile, line);
+    EXPECT_EQ(0u, line.find("time\t3.v\t3.firing\t"));
+    size_t rows(0);
+    while (std::getline(outfile, line)) ++rows;
+    EXPECT_EQ(size_t(3), rows);
+}
+
+TEST(Stimuli, Kinds)
+{
+    Stimuli stimuli;
+    stimuli.addStep({0, 1}, 2, 3, 5.0);
+    stimuli.addPulses({2}, 1, 0, 4.0, 3, 1);
+    stimuli.addSinusoid({3}, 1, 0, 2.0, 250.0, 0.0, 1.0); // period of 4 ms
+    stimuli.addPoisson({4}, 1, 0, 7.0, 1000.0); // a spike at each time step
+    {
+        std::ofstream recording("stimulus_test.bin", std::ios_base::binary);
+        std::vector<double> values{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}; // 3 time steps of 2 targets
+        recording.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(double));
+    }
+    stimuli.addRecording({5, 6}, 2, 0, 10.0, "stimulus_test.bin");
+    EXPECT_THROW(stimuli.addStep({}, 1, 0, 1.0), std::invalid_argument);
+    EXPECT_THROW(stimuli.addRecording({0}, 1, 0, 1.0, "no_such_file.bin"), INPUT_ERROR);
+
+    std::vector<double> current(8, 0.0);
+    std::vector<std::vector<double> > expected{
+        {0, 0, 4, 1+2, 7, 0, 0, 0},     // t=1
+        {5, 5, 0, 1, 7, 10, 20, 0},     // t=2
+        {5, 5, 0, 1-2, 7, 30, 40, 0},   // t=3
+        {0, 0, 4, 1, 7, 50, 60, 0},     // t=4
+        {0, 0, 0, 1+2, 7, 0, 0, 0},     // t=5 : the recording ended
+    };
+    for (size_t t(1); t<=expected.size(); ++t) {
+        stimuli.apply(t, current);
+        for (size_t i(0); i<current.size(); ++i) EXPECT_NEAR(expected[t-1][i], current[i], 1e-9) << "time " << t << ", neuron " << i;
+    }
+    std::remove("stimulus_test.bin");
+}
+
+TEST(Stimuli, LoadAndInject)
+{
+    Network network(_NEURON_NUMBER_,_PROPORTION_EXCITATOR_,_MEAN_CONNECTIVITY_,_MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    {
+        std::ofstream config("stimuli_test.txt");
+        config << "# kind targets start end amplitude parameters\n\n";
+        config << "step 0,1 1 0 1000\n";
+        config << "poisson RS:3 1 10 5 20\n";
+    }
+    network.enableStimuli()->load("stimuli_test.txt", network);
+    EXPECT_EQ(size_t(2), network.getStimuli()->getNumberStimuli());
+    network.update();
+    network.update(); // a neuron fires the time step after it crosses the threshold
+    EXPECT_TRUE(network.getNeurons()[0]->isFiring());
+    EXPECT_TRUE(network.getNeurons()[1]->isFiring());
+
+    std::ofstream("stimuli_test.txt") << "sine 0 1 0 1\n"; // the frequency is missing
+    EXPECT_THROW(network.enableStimuli()->load("stimuli_test.txt", network), std::invalid_argument);
+    std::remove("stimuli_test.txt");
+}
+
+TEST(Simulation, ConfigurationAndSteps) // use as a library : no command line and no output file
+{
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanIntensity = 4;
+    configuration.meanConnectivity = 20;
+    configuration.probes = "0,FS:2";
+    configuration.probeVariables = "v,firing";
+    configuration.statisticsWindow = 10;
+    Simulation simulation(configuration);
+    EXPECT_EQ(size_t(200), simulation.getNetwork()->getNumberNeurons());
+    EXPECT_EQ("0,FS:2", simulation.getConfiguration().probes);
+
+    size_t spikes(0);
+    for (size_t t(1); t<=50; ++t) {
+        EXPECT_EQ(t, simulation.step());
+        std::vector<bool> firing(simulation.getNetwork()->getFiring());
+        EXPECT_EQ(size_t(std::count(firing.begin(), firing.end(), true)), simulation.getNetwork()->getFired().size());
+        for (auto i : simulation.getNetwork()->getFired()) EXPECT_TRUE(simulation.getNetwork()->getNeurons()[i]->isFiring());
+        spikes += simulation.getNetwork()->getFired().size();
+    }
+    EXPECT_EQ(size_t(50), simulation.getTime());
+    ASSERT_NE(nullptr, simulation.getRecorder());
+    EXPECT_EQ(size_t(50), simulation.getRecorder()->getNumberRecords());
+    simulation.getRecorder()->clear();
+    EXPECT_EQ(size_t(60), simulation.step(10));
+    EXPECT_EQ(size_t(10), simulation.getRecorder()->getNumberRecords());
+    ASSERT_NE(nullptr, simulation.getStatistics());
+    EXPECT_EQ(size_t(6), simulation.getStatistics()->getRates().size());
+    EXPECT_GE(std::accumulate(simulation.getStatistics()->getSpikeCounts().begin(), simulation.getStatistics()->getSpikeCounts().end(), size_t(0)), spikes);
+    EXPECT_EQ(size_t(60+_PROBE_BUFFER_ROWS_), simulation.step(_PROBE_BUFFER_ROWS_)); // past the capacity of the buffer
+    EXPECT_EQ(size_t(10+_PROBE_BUFFER_ROWS_), simulation.getRecorder()->getNumberRecords());
+    const Recorder& recorder(*simulation.getRecorder());
+    EXPECT_DOUBLE_EQ(simulation.getNetwork()->getNeurons()[0]->getPotential(), recorder.getRecords()[(recorder.getNumberRecords()-1)*recorder.getProbes().size()*recorder.getVariables().size()]);
+}
+
+TEST(Random, Streams)
+{
+    RandomNumbers legacy(_SEED_), stream(_SEED_, 1), other(_SEED_, 1);
+    std::mt19937 reference(_SEED_);
+    EXPECT_EQ(legacy.uniform_double(0.0, 1.0), std::uniform_real_distribution<>(0.0, 1.0)(reference)); // the stream 0 is the sequence of the seed
+    std::vector<double> first(100), second(100), third(100);
+    legacy.uniform_double(first, 0.0, 1.0);
+    stream.uniform_double(second, 0.0, 1.0);
+    other.uniform_double(third, 0.0, 1.0);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(second, third);
+    EXPECT_EQ(stream.getSeed(), (unsigned long)_SEED_);
+    EXPECT_EQ(stream.getStream(), 1ul);
+}
+
+TEST(Network, IndependentGenerators) // two networks with the same seed evolve identically, whatever the other networks do
+{
+    Network first(200, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_, nullptr, NORMAL_PAGES, 12345);
+    Network other(200, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_, nullptr, NORMAL_PAGES, 12345, 1);
+    Network second(200, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_, nullptr, NORMAL_PAGES, 12345);
+    bool different(false);
+    for (size_t t(0); t<100; ++t) {
+        first.update();
+        other.update();
+        second.update();
+        EXPECT_EQ(first.getFiring(), second.getFiring());
+        if (first.getFiring()!=other.getFiring()) different = true;
+    }
+    EXPECT_TRUE(different);
+    EXPECT_EQ(other.getGenerator().getStream(), size_t(_STREAMS_));
+}
+
+TEST(Network, StreamedLinks)
+{
+    Network streamed(500, _PROPORTION_EXCITATOR_, 40, _MEAN_INTENSITY_, _DELTA_, 'C', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    Network same(500, _PROPORTION_EXCITATOR_, 40, _MEAN_INTENSITY_, _DELTA_, 'C', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    Network dense(20, _PROPORTION_EXCITATOR_, 15, _MEAN_INTENSITY_, _DELTA_, 'C', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS, DOUBLE_WEIGHTS, _REWIRING_, 2.0); // many links drawn by a partial shuffle, kept in the neurons
+    for (const Network* network : {&streamed, &dense}) {
+        Neurons neurons(network->getNeurons());
+        for (auto neuron : neurons) {
+            EXPECT_EQ(neuron->getSizeNeighborhood(), std::min<size_t>(network->getMeanConnectivity(), neurons.size()-1));
+            std::set<Neurone*> linked;
+            for (size_t k(0); k<neuron->getSizeNeighborhood(); ++k) {
+                const NeuroneInteraction& link(neuron->getLink(k));
+                EXPECT_NE(link.neurone, neuron); // no link of a neuron with itself
+                EXPECT_TRUE(link.bondStrength>=0.0 and link.bondStrength<=2*_MEAN_INTENSITY_);
+                linked.insert(link.neurone);
+            }
+            EXPECT_EQ(linked.size(), neuron->getSizeNeighborhood()); // each link is created once
+        }
+    }
+    for (size_t i(0); i<500; ++i) {
+        for (size_t k(0); k<40; ++k) EXPECT_EQ(streamed.findNeuron(streamed.getNeurons()[i]->getLink(k).neurone), same.findNeuron(same.getNeurons()[i]->getLink(k).neurone));
+    }
+    std::ostringstream report;
+    streamed.printMemory(report);
+    EXPECT_NE(report.str().find("construction : peak resident memory"), std::string::npos);
+}
+
+TEST(Topology, SmallWorldAndScaleFree)
+{
+    RandomNumbers generator(_SEED_), sameRing(_SEED_);
+    Topology lattice('W', 1000, 10, 0.0, generator), smallWorld('W', 1000, 10, 0.2, sameRing); // the same ring
+    Topology scaleFree('A', 5000, 10, 0.0, generator);
+    for (const Topology* topology : {&lattice, &smallWorld, &scaleFree}) {
+        for (size_t i(0); i<topology->getNumberNeurons(); ++i) {
+            const uint32_t* sources(topology->getSources(i));
+            for (size_t l(0); l<topology->getDegree(i); ++l) {
+                EXPECT_NE(sources[l], i); // no link of a neuron with itself
+                if (l>0) { EXPECT_LT(sources[l-1], sources[l]); } // sorted, each link is created once
+            }
+        }
+    }
+    size_t rewired(0);
+    for (size_t i(0); i<1000; ++i) {
+        EXPECT_EQ(lattice.getDegree(i), 10u);
+        EXPECT_EQ(smallWorld.getDegree(i), 10u);
+        for (size_t l(0); l<10; ++l) {
+            size_t source(lattice.getSources(i)[l]);
+            const uint32_t* back(lattice.getSources(source));
+            EXPECT_TRUE(std::binary_search(back, back+10, uint32_t(i))); // the ring lattice is symmetric
+            if (!std::binary_search(lattice.getSources(i), lattice.getSources(i)+10, smallWorld.getSources(i)[l])) ++rewired;
+        }
+    }
+    EXPECT_NEAR(rewired/10000.0, 0.2, 0.03);
+
+    EXPECT_EQ(scaleFree.getNumberLinks(), 2*(15+(5000-6)*5u)); // 6 neurons linked together, then 5 links per neuron, in both directions
+    size_t maximum(0);
+    for (size_t i(0); i<5000; ++i) {
+        EXPECT_GE(scaleFree.getDegree(i), 5u);
+        maximum = std::max(maximum, scaleFree.getDegree(i));
+        for (size_t l(0); l<scaleFree.getDegree(i); ++l) {
+            size_t source(scaleFree.getSources(i)[l]);
+            EXPECT_TRUE(std::binary_search(scaleFree.getSources(source), scaleFree.getSources(source)+scaleFree.getDegree(source), uint32_t(i)));
+        }
+    }
+    EXPECT_GT(maximum, 100u); // hubs, much more linked than the mean
+    EXPECT_THROW(Topology('B', 100, 10, 0.0, generator), std::invalid_argument);
+    EXPECT_THROW(Topology('W', 100, 10, 1.5, generator), std::invalid_argument);
+
+    Network network(2000, 0.5, 12, _MEAN_INTENSITY_, _DELTA_, 'A', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    Network same(2000, 0.5, 12, _MEAN_INTENSITY_, _DELTA_, 'A', nullptr, NORMAL_PAGES, _SEED_, 0, SHUFFLED_LINKS, SHORT_WEIGHTS);
+    size_t links(0);
+    for (size_t i(0); i<2000; ++i) {
+        links += network.getDegree(i);
+        ASSERT_EQ(network.getDegree(i), same.getDegree(i)); // the construction does not change the structured networks
+        EXPECT_EQ(network.findNeuron(network.getNeurons()[i]->getLink(0).neurone), same.getQuantizedLinks()->getSource(i, 0));
+    }
+    EXPECT_EQ(links, 2*(21+(2000-7)*6u));
+    EXPECT_THROW(Network(100, 0.5, 10, _MEAN_INTENSITY_, _DELTA_, 'W', nullptr, NORMAL_PAGES, _SEED_, 0, PROCEDURAL_LINKS), std::invalid_argument);
+}
+
+TEST(Network, Views)
+{
+    Network network(300, 0.5, 20, 4, _DELTA_, _NETWORK_MODEL_), quantized(300, 0.5, 20, 4, _DELTA_, _NETWORK_MODEL_, nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS, SHORT_WEIGHTS);
+    EXPECT_EQ(&network.getNeurons(), &network.getNeurons()); // no copy
+    View<Neurone*> owned(network.getOwnedNeurons());
+    ASSERT_EQ(owned.size(), 300u);
+    EXPECT_EQ(owned.begin(), network.getNeurons().data());
+
+    for (size_t t(0); t<5; ++t) network.update();
+    for (size_t i(0); i<300; ++i) {
+        View<NeuroneInteraction> links(owned[i]->getLinks());
+        EXPECT_EQ(links.size(), owned[i]->getSizeNeighborhood());
+        size_t k(0), firing(0);
+        for (const auto& link : links) {
+            EXPECT_EQ(&link, &owned[i]->getLink(k++));
+            if (link.neurone->isFiring()) ++firing;
+        }
+        size_t counted(0);
+        double sum(0.0);
+        network.forEachLink(i, [&](const Neurone* source, double strength) {
+            if (source->isFiring() and source->getExcitator()) sum += strength;
+            ++counted;
+        });
+        EXPECT_EQ(counted, links.size());
+        EXPECT_DOUBLE_EQ(sum, owned[i]->getSumExcitator());
+        counted = 0;
+        quantized.forEachLink(i, [&](const Neurone*, double strength) {
+            EXPECT_LE(strength, 8.0 + 1e-9);
+            ++counted;
+        });
+        EXPECT_EQ(counted, quantized.getDegree(i));
+    }
+
+    Simulation simulation;
+    EXPECT_EQ(&simulation.getNeuronsProportions(), &simulation.getNeuronsProportions());
+}
+
+TEST(ParameterColumns, TextAndColumns)
+{
+    Network network(_NEURON_NUMBER_, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    ParameterColumns columns(network);
+    ASSERT_EQ(columns.getNumberNeurons(), network.getNumberNeurons());
+
+    std::ostringstream lines, text;
+    for (auto neuron : network.getNeurons()) neuron->printParams(lines);
+    columns.print(text);
+    EXPECT_EQ(text.str(), lines.str()); // the same text as the neurons
+
+    std::stringstream binary;
+    columns.write(binary);
+    uint64_t header[2];
+    binary.read(reinterpret_cast<char*>(header), sizeof(header));
+    EXPECT_EQ(header[0], uint64_t(network.getNumberNeurons()));
+    EXPECT_EQ(header[1], uint64_t(NeuronParam.size()));
+    std::vector<std::string> names;
+    for (size_t t(0); t<header[1]; ++t) {
+        uint64_t length;
+        binary.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string name(length, ' ');
+        binary.read(&name[0], length);
+        names.push_back(name);
+    }
+    std::vector<uint8_t> types(header[0]);
+    binary.read(reinterpret_cast<char*>(types.data()), types.size());
+    std::vector<double> a(header[0]);
+    binary.read(reinterpret_cast<char*>(a.data()), a.size()*sizeof(double));
+    binary.seekg(3*header[0]*sizeof(double)+header[0], std::ios_base::cur); // b, c, d and inhibitory
+    std::vector<uint64_t> degrees(header[0]);
+    binary.read(reinterpret_cast<char*>(degrees.data()), degrees.size()*sizeof(uint64_t));
+    std::vector<double> valences(header[0]);
+    binary.read(reinterpret_cast<char*>(valences.data()), valences.size()*sizeof(double));
+    ASSERT_TRUE(binary.good());
+    EXPECT_EQ(binary.peek(), EOF);
+    for (size_t i(0); i<network.getNumberNeurons(); ++i) {
+        Neurone* neuron(network.getNeurons()[i]);
+        EXPECT_TRUE(neuron->isType(names[types[i]]));
+        EXPECT_EQ(a[i], neuron->getParameters().a);
+        EXPECT_EQ(degrees[i], neuron->getSizeNeighborhood());
+        EXPECT_EQ(valences[i], neuron->getValence());
+    }
+}
+
+TEST(TextBuffer, SameTextAsStreams)
+{
+    RandomNumbers generator(_SEED_);
+    std::vector<double> values{0.0, -0.0, 1.0, -65.0, 0.02, 1e-7, 123456.5, 1234567.0, -3.14159265, 1e300, -2.5e-310, std::numeric_limits<double>::infinity()};
+    for (size_t k(0); k<1000; ++k) values.push_back(generator.normal(0.0, std::pow(10.0, generator.uniform_double(-8.0, 8.0))));
+    std::vector<size_t> integers{0, 7, 10, 99, 1000, 123456789, std::numeric_limits<size_t>::max()};
+
+    TextBuffer text(16); // the buffer grows beyond its capacity
+    std::ostringstream expected;
+    for (auto value : values) {
+        text << value << '\t';
+        expected << value << "\t";
+    }
+    for (auto integer : integers) {
+        text << integer << " " << (integer%2==0) << std::string("\n");
+        expected << integer << " " << (integer%2==0) << "\n";
+    }
+    EXPECT_TRUE(text.isFull());
+    EXPECT_EQ(text.str(), expected.str());
+
+    std::ostringstream written;
+    text.write(written);
+    EXPECT_EQ(written.str(), expected.str());
+    EXPECT_EQ(text.size(), size_t(0));
+
+    Network network(_NEURON_NUMBER_, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    for (size_t t(1); t<=20; ++t) {
+        network.update();
+        std::ostringstream spikes, sample;
+        network.printSpikes(spikes, t);
+        network.printSample(sample, t);
+        std::ostringstream oldSpikes, oldSample; // the text written by the previous versions
+        oldSpikes << t;
+        for (auto neuron : network.getNeurons()) oldSpikes << " " << neuron->isFiring();
+        oldSpikes << std::endl;
+        oldSample << t;
+        for (const auto& type : network.getNeuronsProportions()) {
+            for (auto neuron : network.getNeurons()) {
+                if (!neuron->isType(type.first)) continue;
+                oldSample << "\t" << neuron->getPotential() << "\t" << neuron->getRelaxation() << "\t" << neuron->getCurrent();
+                break;
+            }
+        }
+        oldSample << std::endl;
+        EXPECT_EQ(spikes.str(), oldSpikes.str());
+        EXPECT_EQ(sample.str(), oldSample.str());
+    }
+}
+
+TEST(Network, SpikesFormats)
+{
+    Network network(_NEURON_NUMBER_, _PROPORTION_EXCITATOR_, _MEAN_CONNECTIVITY_, _MEAN_INTENSITY_, _DELTA_, _NETWORK_MODEL_);
+    std::ostringstream header;
+    network.headerSpikes(header, EVENT_SPIKES);
+    EXPECT_EQ(header.str(), "# spikes of " + std::to_string(_NEURON_NUMBER_) + " neurons : time neuron\n");
+    size_t spikes(0);
+    for (size_t t(1); t<=50; ++t) {
+        network.update();
+        std::ostringstream raster, events, ids;
+        network.printSpikes(raster, t);
+        network.printSpikes(events, t, EVENT_SPIKES);
+        network.printSpikes(ids, t, ID_SPIKES);
+
+        std::istringstream rasterLine(raster.str()), eventLines(events.str()), idLine(ids.str());
+        size_t time, id, number(0);
+        ASSERT_TRUE(bool(rasterLine >> time));
+        ASSERT_TRUE(bool(idLine >> time));
+        EXPECT_EQ(time, t);
+        std::vector<size_t> fromRaster, fromEvents, fromIds;
+        for (bool firing; rasterLine >> firing; ++number) if (firing) fromRaster.push_back(number);
+        EXPECT_EQ(number, size_t(_NEURON_NUMBER_));
+        while (eventLines >> time >> id) {
+            EXPECT_EQ(time, t);
+            fromEvents.push_back(id);
+        }
+        while (idLine >> id) fromIds.push_back(id);
+        EXPECT_EQ(fromEvents, fromRaster); // the three formats give the same spikes
+        EXPECT_EQ(fromIds, fromRaster);
+        std::string idText(ids.str());
+        EXPECT_EQ(std::count(idText.begin(), idText.end(), '\n'), 1);
+        spikes += fromRaster.size();
+    }
+    EXPECT_GT(spikes, size_t(0));
+}
+
+TEST(Network, DenseLinks)
+{
+    Network sparse(300, 0.8, 120, _MEAN_INTENSITY_, _DELTA_, 'C', nullptr, NORMAL_PAGES, _SEED_, 0, SHUFFLED_LINKS, DOUBLE_WEIGHTS, _REWIRING_, 2.0); // above 1 : never dense
+    Network dense(300, 0.8, 120, _MEAN_INTENSITY_, _DELTA_, 'C'); // 120/299 is above the default threshold
+    EXPECT_TRUE(dense.hasDenseLinks());
+    EXPECT_FALSE(sparse.hasDenseLinks());
+    EXPECT_FALSE(Network(300, 0.8, 60, _MEAN_INTENSITY_, _DELTA_, 'C').hasDenseLinks()); // 60/299 is below
+    EXPECT_FALSE(Network(300, 0.8, 120, _MEAN_INTENSITY_, _DELTA_, 'C', nullptr, NORMAL_PAGES, _SEED_, 0, SHUFFLED_LINKS, SHORT_WEIGHTS).hasDenseLinks());
+    EXPECT_EQ(dense.getNeurons()[0]->getSizeNeighborhood(), 0); // the links are only in the matrix
+    for (size_t i(0); i<300; ++i) {
+        EXPECT_EQ(dense.getDegree(i), sparse.getDegree(i)); // the same random sequence draws the same links
+        EXPECT_NEAR(dense.getValence(i), sparse.getValence(i), 1e-4);
+        size_t visited(0);
+        double valence(0.0);
+        dense.forEachLink(i, [&](const Neurone* source, double strength) {
+            ++visited;
+            valence += source->getExcitator() ? 0.5*strength : -strength;
+        });
+        EXPECT_EQ(visited, dense.getDegree(i));
+        EXPECT_NEAR(valence, dense.getValence(i), 1e-9);
+    }
+    for (size_t t(0); t<30; ++t) {
+        sparse.update();
+        dense.update();
+        for (size_t i(0); i<300; ++i) {
+            EXPECT_NEAR(dense.getNeurons()[i]->getCurrent(), sparse.getNeurons()[i]->getCurrent(), 1e-4); // single precision strengths, summed in another order
+            dense.getNeurons()[i]->setFiringState(sparse.getNeurons()[i]->isFiring()); // a different rounding could change a spike
+        }
+    }
+    EXPECT_THROW(dense.enablePlasticity(), std::invalid_argument);
+}
+
+TEST(Network, Synapses)
+{
+    Network instantaneous(300, 0.5, 30, 4, _DELTA_, _NETWORK_MODEL_);
+    Network fast(300, 0.5, 30, 4, _DELTA_, _NETWORK_MODEL_), decaying(300, 0.5, 30, 4, _DELTA_, _NETWORK_MODEL_), conductance(300, 0.5, 30, 4, _DELTA_, _NETWORK_MODEL_);
+    fast.setSynapses({CURRENT_SYNAPSES, 1e-3, 1e-3}); // the sums decay completely in one time step
+    decaying.setSynapses({CURRENT_SYNAPSES, 5.0, 10.0});
+    conductance.setSynapses({CONDUCTANCE_SYNAPSES, 5.0, 10.0});
+    EXPECT_THROW(decaying.setSynapses({CURRENT_SYNAPSES, 0.0, 10.0}), std::invalid_argument);
+    EXPECT_EQ(decaying.getSynapses().excitatoryTau, 5.0);
+
+    double decay(std::exp(-1.0/5.0));
+    size_t differentSpikes(0);
+    for (int t(0); t<100; ++t) {
+        double before(decaying.getSynapticExcitation(7)), sum(decaying.getNeurons()[7]->getSumExcitator()); // the firing states used by the next update
+        instantaneous.update();
+        fast.update();
+        decaying.update();
+        conductance.update();
+        EXPECT_EQ(instantaneous.getFired(), fast.getFired());
+        EXPECT_NEAR(decaying.getSynapticExcitation(7), decay*before + (1.0-decay)*sum, 1e-9); // same total charge as the instantaneous current
+        if (decaying.getFired()!=conductance.getFired()) ++differentSpikes;
+    }
+    EXPECT_EQ(instantaneous.getSynapticExcitation(7), 0.0);
+    EXPECT_GT(decaying.getSynapticInhibition(7), 0.0);
+    EXPECT_GT(differentSpikes, 0u);
+}
+
+TEST(QuantizedLinks, Rounding)
+{
+    QuantizedLinks links(BYTE_WEIGHTS);
+    links.addNeuron({3, 0, 7}, {1.0, 0.5, 0.001});
+    links.addNeuron({}, {});
+    EXPECT_EQ(links.getNumberNeurons(), 2);
+    EXPECT_EQ(links.getNumberLinks(), 3);
+    EXPECT_EQ(links.getNumberLinks(1), 0);
+    EXPECT_EQ(links.getSource(0, 2), 7);
+    EXPECT_DOUBLE_EQ(links.getStrength(0, 0), 1.0); // the largest strength is exact
+    EXPECT_NEAR(links.getStrength(0, 1), 0.5, 0.5*links.getScale(0));
+    EXPECT_NEAR(links.getStrength(0, 2), 0.001, 0.5*links.getScale(0));
+    std::vector<uint8_t> states(8, 0);
+    states[3] = 1;
+    states[7] = 2;
+    double excitation, inhibition;
+    links.sums(0, states, excitation, inhibition);
+    EXPECT_DOUBLE_EQ(excitation, 1.0);
+    EXPECT_DOUBLE_EQ(inhibition, links.getStrength(0, 2));
+    links.sums(1, states, excitation, inhibition);
+    EXPECT_EQ(excitation, 0.0);
+    EXPECT_EQ(inhibition, 0.0);
+    EXPECT_THROW(links.addNeuron({1}, {-1.0}), std::invalid_argument);
+
+    Arena arena;
+    QuantizedLinks stored(SHORT_WEIGHTS, &arena);
+    stored.reserve(2, 3);
+    size_t used(arena.getUsed());
+    EXPECT_GE(used, 3*(sizeof(uint32_t)+sizeof(uint16_t))+3*sizeof(uint64_t)+2*sizeof(double));
+    stored.addNeuron({3, 0, 7}, {1.0, 0.5, 0.001});
+    stored.addNeuron({}, {});
+    EXPECT_EQ(arena.getUsed(), used); // the arrays do not grow once reserved
+    EXPECT_EQ(stored.getStrength(0, 0), 1.0);
+}
+
+TEST(Network, QuantizedLinks)
+{
+    Network full(1000, 0.8, 100, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    for (auto weights : {SHORT_WEIGHTS, BYTE_WEIGHTS}) {
+        Network quantized(1000, 0.8, 100, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS, weights);
+        ASSERT_NE(quantized.getQuantizedLinks(), nullptr);
+        EXPECT_EQ(quantized.getNeurons()[0]->getSizeNeighborhood(), 0); // the links are only in the compact array
+        for (size_t i(0); i<1000; ++i) {
+            EXPECT_EQ(quantized.getDegree(i), full.getDegree(i));
+            EXPECT_NEAR(quantized.getValence(i), full.getValence(i), full.getDegree(i)*0.5*quantized.getQuantizedLinks()->getScale(i));
+        }
+        EXPECT_LT(quantized.getQuantizedLinks()->getMemory(), full.getNumberNeurons()*100*(weights==SHORT_WEIGHTS ? 7 : 6)); // instead of 16 bytes per link
+        EXPECT_THROW(quantized.enablePlasticity(), std::invalid_argument);
+
+        Network reference(1000, 0.8, 100, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+        size_t spikesReference(0), spikesQuantized(0);
+        for (size_t t(0); t<300; ++t) {
+            reference.update();
+            quantized.update();
+            spikesReference += reference.getFired().size();
+            spikesQuantized += quantized.getFired().size();
+        }
+        EXPECT_GT(spikesReference, 1000);
+        EXPECT_NEAR(double(spikesQuantized)/spikesReference, 1.0, 0.05); // the same firing rate, the spikes themselves diverge with the rounding
+    }
+}
+
+TEST(ProceduralLinks, DistinctSources)
+{
+    ProceduralLinks all(300, 0, _SEED_, 0, 1.0), owned(300, 100, _SEED_, 0, 1.0);
+    for (size_t i(0); i<300; ++i) all.addNeuron(i==7 ? 299 : 50);
+    for (size_t i(100); i<200; ++i) owned.addNeuron(50);
+    EXPECT_EQ(all.getNumberLinks(), 299*50+299);
+    double mean(0.0);
+    for (size_t i(0); i<300; ++i) {
+        std::set<size_t> sources;
+        for (size_t k(0); k<all.getNumberLinks(i); ++k) {
+            size_t source(all.getSource(i, k));
+            EXPECT_NE(source, i);
+            EXPECT_LT(source, 300);
+            sources.insert(source);
+            double strength(all.getStrength(i, k));
+            EXPECT_GE(strength, 0.0);
+            EXPECT_LT(strength, 1.0);
+            mean += strength/all.getNumberLinks();
+        }
+        EXPECT_EQ(sources.size(), all.getNumberLinks(i)); // the links of a neuron are distinct
+    }
+    EXPECT_NEAR(mean, 0.5, 0.01);
+    for (size_t k(0); k<50; ++k) { // the links only depend on the seed and on the indices of the neuron and of the link
+        EXPECT_EQ(owned.getSource(30, k), all.getSource(130, k));
+        EXPECT_EQ(owned.getStrength(30, k), all.getStrength(130, k));
+    }
+
+    std::vector<uint8_t> states(300, 0);
+    for (size_t j(0); j<300; j+=3) states[j] = j%2 ? 1 : 2;
+    double excitation, inhibition, expectedExcitation(0.0), expectedInhibition(0.0);
+    all.sums(5, states, excitation, inhibition);
+    for (size_t k(0); k<all.getNumberLinks(5); ++k) {
+        size_t source(all.getSource(5, k));
+        if (states[source]==1) expectedExcitation += all.getStrength(5, k);
+        if (states[source]==2) expectedInhibition += all.getStrength(5, k);
+    }
+    EXPECT_DOUBLE_EQ(excitation, expectedExcitation);
+    EXPECT_DOUBLE_EQ(inhibition, expectedInhibition);
+}
+
+TEST(Network, ProceduralLinks)
+{
+    Network stored(1000, 0.8, 100, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    Network procedural(1000, 0.8, 100, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, PROCEDURAL_LINKS);
+    ASSERT_NE(procedural.getProceduralLinks(), nullptr);
+    EXPECT_EQ(procedural.getNeurons()[0]->getSizeNeighborhood(), 0);
+    for (size_t i(0); i<1000; ++i) EXPECT_EQ(procedural.getDegree(i), stored.getDegree(i)); // the same random sequence draws the numbers of links
+    EXPECT_LT(procedural.getProceduralLinks()->getMemory(), 1000*sizeof(uint64_t));
+    EXPECT_FALSE(procedural.hasDenseLinks());
+    EXPECT_THROW(procedural.enablePlasticity(), std::invalid_argument);
+    EXPECT_THROW(Network(100, 0.8, 10, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, PROCEDURAL_LINKS, BYTE_WEIGHTS), std::invalid_argument);
+
+    size_t spikesStored(0), spikesProcedural(0);
+    for (size_t t(0); t<300; ++t) {
+        stored.update();
+        procedural.update();
+        spikesStored += stored.getFired().size();
+        spikesProcedural += procedural.getFired().size();
+    }
+    EXPECT_NEAR(double(spikesProcedural)/spikesStored, 1.0, 0.1); // another network with the same statistics
+}
+
+TEST(LatencyHistogram, Percentiles)
+{
+    LatencyHistogram latencies(90000);
+    EXPECT_EQ(latencies.getPercentile(50), 0);
+    for (uint64_t value(1); value<=100000; ++value) latencies.record(value);
+    EXPECT_EQ(latencies.getCount(), 100000);
+    EXPECT_EQ(latencies.getMisses(), 10000);
+    EXPECT_EQ(latencies.getMinimum(), 1);
+    EXPECT_EQ(latencies.getMaximum(), 100000);
+    EXPECT_DOUBLE_EQ(latencies.getMean(), 50000.5);
+    for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+        double exact(percentile*1000);
+        EXPECT_GE(latencies.getPercentile(percentile), exact);
+        EXPECT_LE(latencies.getPercentile(percentile), exact*(1.0+1.0/64));
+    }
+    EXPECT_EQ(latencies.getPercentile(100), 100000);
+
+    LatencyHistogram small;
+    for (uint64_t value : {3, 3, 5, 100}) small.record(value); // the values below 128 are exact
+    EXPECT_EQ(small.getPercentile(50), 3);
+    EXPECT_EQ(small.getPercentile(75), 5);
+    EXPECT_EQ(small.getMisses(), 0);
+    small.record(uint64_t(1) << 62);
+    EXPECT_EQ(small.getMaximum(), uint64_t(1) << 62);
+}
+
+TEST(Simulation, Pace)
+{
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanConnectivity = 20;
+    configuration.duration = 100;
+    configuration.pace = 20.0; // a time step every 50 microseconds
+    configuration.outfileName = "test_pace";
+    Simulation simulation(configuration);
+    std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    EXPECT_EQ(simulation.run(), size_t(100));
+    EXPECT_GE(std::chrono::steady_clock::now()-start, std::chrono::microseconds(100*50)); // each time step waits for the next one
+    ASSERT_NE(simulation.getLatencies(), nullptr);
+    EXPECT_EQ(simulation.getLatencies()->getCount(), 100);
+    EXPECT_EQ(simulation.getLatencies()->getDeadline(), 50000);
+    std::ifstream latency("test_pace_latency.txt");
+    std::string line;
+    std::getline(latency, line);
+    EXPECT_EQ(line.substr(0, 13), "# 100 values,");
+
+    configuration.pace = 0.0; // the files written by the worker threads are the ones of the same simulation without a pace
+    configuration.outfileName = "test_unpaced";
+    Simulation(configuration).run();
+    for (std::string suffix : {"_spikes.txt", "_parameters.txt", "_sample_neurons.txt"}) {
+        std::ifstream paced("test_pace"+suffix), unpaced("test_unpaced"+suffix);
+        std::stringstream pacedText, unpacedText;
+        pacedText << paced.rdbuf();
+        unpacedText << unpaced.rdbuf();
+        EXPECT_FALSE(pacedText.str().empty());
+        EXPECT_EQ(pacedText.str(), unpacedText.str());
+        std::remove(("test_unpaced"+suffix).c_str());
+    }
+    for (std::string suffix : {"_spikes.txt", "_parameters.txt", "_sample_neurons.txt", "_latency.txt"}) std::remove(("test_pace"+suffix).c_str());
+}
+
+TEST(EarlyStop, Criteria)
+{
+    EarlyStop quiet(100, 3, 0, 0.0);
+    EXPECT_FALSE(quiet.record(0, 1));
+    EXPECT_FALSE(quiet.record(0, 2));
+    EXPECT_FALSE(quiet.record(4, 3)); // a spike starts the count again
+    EXPECT_FALSE(quiet.record(0, 4));
+    EXPECT_FALSE(quiet.record(0, 5));
+    EXPECT_TRUE(quiet.record(0, 6));
+    EXPECT_TRUE(quiet.record(7, 7));
+    EXPECT_EQ(quiet.getTime(), 6u);
+    EXPECT_EQ(quiet.getReason().substr(0, 10), "quiescence");
+
+    std::vector<size_t> counts({3, 8, 1, 5, 9, 2, 6});
+    EarlyStop steady(100, 0, 4, 0.0);
+    for (size_t t(0); t<counts.size(); ++t) {
+        EXPECT_FALSE(steady.record(counts[t], t+1));
+        if (t<3) continue;
+        double mean(0.0), variance(0.0), scale(1000.0/(100*_DT_));
+        for (size_t w(t-3); w<=t; ++w) mean += counts[w]*scale/4;
+        for (size_t w(t-3); w<=t; ++w) variance += std::pow(counts[w]*scale-mean, 2)/4;
+        EXPECT_NEAR(steady.getVariance(), variance, 1e-9*variance);
+    }
+    EarlyStop flat(100, 0, 4, 1.0);
+    for (size_t t(1); t<=3; ++t) EXPECT_FALSE(flat.record(5, t)); // the window is not full
+    EXPECT_TRUE(flat.record(5, 4));
+    EXPECT_EQ(flat.getVariance(), 0.0);
+    EXPECT_THROW(EarlyStop(100, 0, 4, -1.0), std::invalid_argument);
+
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanConnectivity = 20;
+    configuration.duration = 1000;
+    configuration.steadyWindow = 50;
+    configuration.steadyVariance = 1e12; // any activity is steady : the run stops as soon as the window is full
+    configuration.outfileName = "test_stop";
+    Simulation simulation(configuration);
+    EXPECT_EQ(simulation.run(), size_t(50));
+    ASSERT_NE(simulation.getEarlyStop(), nullptr);
+    EXPECT_TRUE(simulation.getEarlyStop()->isStopped());
+    EXPECT_EQ(simulation.getEarlyStop()->getReason().substr(0, 12), "steady state");
+    EXPECT_EQ(simulation.step(10), size_t(50)); // a stopped simulation does not go on
+    std::ifstream stop("test_stop_stop.txt");
+    std::string line;
+    std::getline(stop, line);
+    EXPECT_EQ(line.substr(0, 31), "stopped at time step 50 of 1000");
+    for (std::string suffix : {"_spikes.txt", "_parameters.txt", "_sample_neurons.txt", "_stop.txt"}) std::remove(("test_stop"+suffix).c_str());
+}
+
+TEST(Accuracy, QuantizedAndFull)
+{
+    Network full(500, 0.8, 50, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS);
+    Accuracy same(new Network(500, 0.8, 50, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS), full, 100, 20);
+    Network quantized(500, 0.8, 50, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS, BYTE_WEIGHTS);
+    Accuracy rounded(new Network(500, 0.8, 50, _MEAN_INTENSITY_, _DELTA_, 'B', nullptr, NORMAL_PAGES, _SEED_, 0, STREAMED_LINKS), quantized, 300, 20);
+    for (size_t t(1); t<=300; ++t) {
+        full.update();
+        same.record(full.getFired(), t);
+        quantized.update();
+        rounded.record(quantized.getFired(), t);
+    }
+    EXPECT_TRUE(same.isDone());
+    EXPECT_EQ(same.getSteps(), 100u); // the following time steps are not compared
+    EXPECT_EQ(same.getReference(), nullptr);
+    for (size_t t(0); t<same.getQuantizedStatistics().getTypes().size(); ++t) { // the same network gives the same spikes
+        EXPECT_EQ(same.getQuantizedStatistics().getTypeSpikes(t), same.getReferenceStatistics().getTypeSpikes(t));
+        EXPECT_EQ(same.getQuantizedStatistics().getFanoFactor(t), same.getReferenceStatistics().getFanoFactor(t));
+    }
+    const Statistics& statistics(rounded.getQuantizedStatistics());
+    size_t spikes(0), reference(0);
+    for (size_t t(0); t<statistics.getTypes().size(); ++t) {
+        spikes += statistics.getTypeSpikes(t);
+        reference += rounded.getReferenceStatistics().getTypeSpikes(t);
+        EXPECT_NEAR(statistics.getRate(t), 1000.0*statistics.getTypeSpikes(t)/(300.0*full.getNeuronsProportions().at(statistics.getTypes()[t])), 1e-9);
+    }
+    EXPECT_EQ(spikes, std::accumulate(statistics.getSpikeCounts().begin(), statistics.getSpikeCounts().end(), size_t(0)));
+    EXPECT_NEAR(double(spikes)/reference, 1.0, 0.05);
+    std::ostringstream report;
+    rounded.print(report);
+    EXPECT_NE(report.str().find("over the first 300 time steps"), std::string::npos);
+    EXPECT_NE(report.str().find("\nall\t" + std::to_string(spikes) + "\t" + std::to_string(reference)), std::string::npos);
+    EXPECT_THROW(Accuracy(new Network(100, 0.8, 10, _MEAN_INTENSITY_, _DELTA_, 'B'), quantized, 10, 5), std::invalid_argument);
+
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanConnectivity = 20;
+    configuration.weights = SHORT_WEIGHTS;
+    configuration.accuracySteps = 50;
+    Simulation simulation(configuration);
+    ASSERT_NE(simulation.getAccuracy(), nullptr);
+    simulation.step(80);
+    EXPECT_TRUE(simulation.getAccuracy()->isDone());
+    configuration.weights = DOUBLE_WEIGHTS; // nothing to compare
+    EXPECT_EQ(Simulation(configuration).getAccuracy(), nullptr);
+}
+
+#ifdef __unix__
+std::string readSocket(const std::string& name)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, name.c_str(), sizeof(address.sun_path)-1);
+    int connection(::socket(AF_UNIX, SOCK_STREAM, 0));
+    std::string text;
+    if (::connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address))==0) {
+        char buffer[4096];
+        ssize_t read;
+        while ((read = ::recv(connection, buffer, sizeof(buffer), 0))>0) text.append(buffer, read);
+    }
+    ::close(connection);
+    return text;
+}
+
+TEST(MetricsServer, Socket)
+{
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanConnectivity = 20;
+    configuration.meanIntensity = 4;
+    configuration.outfileName = "test_metrics";
+    configuration.metricsSocket = "test_metrics.sock";
+    Simulation simulation(configuration);
+    simulation.step(10); // the last time step of the simulation publishes the metrics
+    ASSERT_NE(simulation.getMetrics(), nullptr);
+    std::string text(readSocket("test_metrics.sock"));
+    EXPECT_NE(text.find("neurons_step 10\n"), std::string::npos);
+    EXPECT_NE(text.find("neurons_duration 10\n"), std::string::npos);
+    EXPECT_NE(text.find("neurons_rate_hz{type=\"FS\"} "), std::string::npos);
+    EXPECT_NE(text.find("neurons_resident_bytes "), std::string::npos);
+    simulation.step(5);
+    EXPECT_NE(readSocket("test_metrics.sock").find("neurons_step 15\n"), std::string::npos);
+
+    Configuration wrong(configuration);
+    wrong.metricsSocket = "no_directory/test_metrics.sock";
+    Simulation failing(wrong);
+    EXPECT_THROW(failing.step(), OUTPUT_ERROR);
+}
+
+TEST(SpikeRing, ReadWhileWriting)
+{
+    std::unique_ptr<SpikeRing> ring(new SpikeRing("test_spike_ring", 100, 3)); // rounded to 4 slots
+    SpikeReader reader("/test_spike_ring");
+    EXPECT_EQ(reader.getNumberNeurons(), 100u);
+    std::vector<size_t> fired, all(100);
+    for (size_t i(0); i<all.size(); ++i) all[i] = i;
+    size_t time(0);
+    EXPECT_FALSE(reader.next(time, fired));
+
+    ring->publish(1, {3, 64, 99}); // a list of indices
+    ring->publish(2, all); // a bitset
+    ring->publish(3, {});
+    EXPECT_EQ(reader.available(), 3u);
+    ASSERT_TRUE(reader.next(time, fired));
+    EXPECT_EQ(time, 1u);
+    EXPECT_EQ(fired, std::vector<size_t>({3, 64, 99}));
+    ASSERT_TRUE(reader.next(time, fired));
+    EXPECT_EQ(time, 2u);
+    EXPECT_EQ(fired, all);
+    ASSERT_TRUE(reader.next(time, fired));
+    EXPECT_EQ(time, 3u);
+    EXPECT_TRUE(fired.empty());
+    EXPECT_FALSE(reader.next(time, fired));
+
+    for (size_t t(4); t<=10; ++t) ring->publish(t, {t});
+    ASSERT_TRUE(reader.next(time, fired)); // the time steps 4 to 6 were overwritten
+    EXPECT_EQ(time, 7u);
+    EXPECT_EQ(fired, std::vector<size_t>({7}));
+    EXPECT_EQ(reader.getLost(), 3u);
+    EXPECT_FALSE(reader.isClosed());
+    ring.reset();
+    EXPECT_TRUE(reader.isClosed()); // the mapping of the reader stays valid
+    EXPECT_EQ(reader.available(), 3u);
+    EXPECT_THROW(SpikeReader("/test_spike_ring"), INPUT_ERROR);
+
+    Configuration configuration;
+    configuration.neuronNumber = 200;
+    configuration.meanConnectivity = 20;
+    configuration.meanIntensity = 4;
+    configuration.spikeRing = "test_spike_ring";
+    Simulation simulation(configuration);
+    simulation.step(5);
+    ASSERT_NE(simulation.getSpikeRing(), nullptr);
+    SpikeReader follower("test_spike_ring");
+    for (size_t t(1); t<=5; ++t) ASSERT_TRUE(follower.next(time, fired));
+    EXPECT_EQ(time, 5u);
+    EXPECT_EQ(fired, simulation.getNetwork()->getFired());
+    EXPECT_EQ(follower.getLost(), 0u);
+}
+#endif
+
+TEST(OutputFile, AsyncBlocks)
+{
+    std::string expected;
+    {
+        AsyncOutput outfile("test_async.txt", 1000, 2); // small blocks and a short queue : the stream waits for the worker
+        ASSERT_TRUE(outfile.is_open());
+        TextBuffer text(1000);
+        for (size_t i(0); i<5000; ++i) {
+            if (i>=4000 and i%7==0) { // the last lines are also written in the stream
+                outfile.submit(text); // copied in the current block, before the next line
+                outfile << i << std::endl;
+            } else {
+                text << i << '\n';
+                if (text.isFull()) outfile.submit(text); // exchanged with a written block when the current one is empty
+            }
+            expected += std::to_string(i) + "\n";
+            if (i==3999) {
+                EXPECT_EQ(outfile.getBytesIn()+text.size(), expected.size()); // the full texts were handed over without the stream
+            }
+        }
+        outfile.submit(text);
+        EXPECT_EQ(text.size(), size_t(0));
+        outfile.close();
+        EXPECT_FALSE(outfile.is_open());
+        EXPECT_EQ(outfile.getBytesIn(), expected.size());
+        EXPECT_EQ(outfile.getBytesOut(), expected.size());
+    }
+    std::ifstream infile("test_async.txt");
+    std::stringstream written;
+    written << infile.rdbuf();
+    std::remove("test_async.txt");
+    EXPECT_EQ(written.str(), expected);
+}
+
+#ifdef NEURONS_ZLIB
+std::string readCompressed(const std::string& name)
+{
+    std::string text, buffer(4096, '\0');
+    gzFile infile(gzopen(name.c_str(), "rb"));
+    if (!infile) return text;
+    int read;
+    while ((read = gzread(infile, &buffer[0], buffer.size()))>0) text.append(buffer, 0, read);
+    gzclose(infile);
+    return text;
+}
+
+TEST(OutputFile, CompressedBlocks)
+{
+    std::string expected;
+    {
+        CompressedOutput outfile("test_compressed.txt.gz", 1000); // small blocks : many gzip members
+        ASSERT_TRUE(outfile.is_open());
+        for (size_t i(0); i<5000; ++i) {
+            outfile << i << " " << i%2 << std::endl;
+            expected += std::to_string(i) + " " + std::to_string(i%2) + "\n";
+        }
+        outfile.close();
+        EXPECT_EQ(outfile.getBytesIn(), expected.size());
+        EXPECT_LT(outfile.getBytesOut(), expected.size());
+    }
+    EXPECT_EQ(readCompressed("test_compressed.txt.gz"), expected);
+}
+
+TEST(OutputFile, CompressedSimulation)
+{
+    Simulation simulation;
+    simulation.run();
+    std::ifstream text(std::string(_OUTFILE_NAME_)+"_spikes.txt");
+    std::stringstream expected;
+    expected << text.rdbuf();
+
+    Simulation compressed;
+    compressed.setCompression(true);
+    compressed.run();
+    std::string spikes(readCompressed(std::string(_OUTFILE_NAME_)+"_spikes.txt.gz"));
+    EXPECT_EQ(std::count(spikes.begin(), spikes.end(), '\n'), _SIMULATION_TIME_);
+    EXPECT_EQ(spikes.size(), expected.str().size()); // same layout, only the spikes differ (the random sequence goes on)
+    EXPECT_FALSE(readCompressed(std::string(_OUTFILE_NAME_)+"_parameters.txt.gz").empty());
+    EXPECT_FALSE(readCompressed(std::string(_OUTFILE_NAME_)+"_sample_neurons.txt.gz").empty());
+}
+#endif
+
 //tests for spikes output file dimensions
 TEST(OutputFile, DimensionCheck)
 {
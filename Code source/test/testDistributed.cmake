@@ -0,0 +1,24 @@
+# Runs the same simulation on a single process and on 4 MPI processes and checks that the output files are identical.
+# Usage : cmake -DMPIEXEC=mpiexec -DSINGLE=Neurons -DDISTRIBUTED=NeuronsMPI -P testDistributed.cmake
+
+set(ENV{OMPI_ALLOW_RUN_AS_ROOT} 1) # needed by OpenMPI in containers
+set(ENV{OMPI_ALLOW_RUN_AS_ROOT_CONFIRM} 1)
+set(ENV{OMPI_MCA_rmaps_base_oversubscribe} 1) # more processes than cores is fine for a test
+file(WRITE stimuli_distributed.txt "step FS:10 20 80 10\npoisson random:50 1 0 8 30\n")
+set(ARGS -N 300 -P 0.8 -t 200 -C 20 -I 7 -M O -S -T IB:0.2,FS:0.2,LTS:0.1 -L 5,FS:3,random:20 -D 3 -U stimuli_distributed.txt)
+
+execute_process(COMMAND ${SINGLE} ${ARGS} -O single RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "the single process run failed")
+endif()
+execute_process(COMMAND ${MPIEXEC} -n 4 ${DISTRIBUTED} ${ARGS} -O distributed RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "the distributed run failed")
+endif()
+
+foreach(suffix _spikes.txt _parameters.txt _sample_neurons.txt _probes.txt)
+  execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files single${suffix} distributed${suffix} RESULT_VARIABLE different)
+  if (different)
+    message(FATAL_ERROR "single${suffix} and distributed${suffix} are different")
+  endif()
+endforeach()